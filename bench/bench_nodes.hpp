@@ -0,0 +1,107 @@
+#pragma once
+
+#include "flow_ffi.h"
+
+#include <flow/core/Node.hpp>
+#include <flow/core/NodeFactory.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "env_wrapper.hpp"
+#include "handle_manager.hpp"
+
+// Helpers shared by the benchmarks: a trivial node class and synthetic graph builders.
+// Everything is driven through the C API except registering the node class.
+
+namespace flow_ffi_bench {
+
+constexpr const char* kPassThroughClass = "bench.PassThrough";
+constexpr const char* kMergeClass = "bench.Merge";
+
+// Forwards its int input to its output
+class PassThroughNode : public flow::Node {
+public:
+    PassThroughNode(const flow::UUID& uuid, const std::string& class_name, std::string name,
+                    std::shared_ptr<flow::Env> env)
+        : flow::Node(uuid, class_name, std::move(name), std::move(env)) {
+        AddInput<int>("in", "Input");
+        AddOutput<int>("out", "Output");
+    }
+
+protected:
+    void Compute() override { SetOutputData("out", GetInputData("in")); }
+};
+
+// Forwards whichever of its two int inputs is set, so it can sit anywhere in a DAG
+class MergeNode : public flow::Node {
+public:
+    MergeNode(const flow::UUID& uuid, const std::string& class_name, std::string name,
+              std::shared_ptr<flow::Env> env)
+        : flow::Node(uuid, class_name, std::move(name), std::move(env)) {
+        AddInput<int>("a", "A");
+        AddInput<int>("b", "B");
+        AddOutput<int>("out", "Output");
+    }
+
+protected:
+    void Compute() override {
+        const auto& a = GetInputData("a");
+        SetOutputData("out", a ? a : GetInputData("b"));
+    }
+};
+
+// An environment with the bench node classes registered
+struct BenchEnv {
+    FlowEnvHandle env = nullptr;
+    FlowNodeFactoryHandle factory = nullptr;
+
+    explicit BenchEnv(int threads = 1) {
+        env = flow_env_create(threads);
+        factory = flow_env_get_factory(env);
+        auto* wrapper = flow_ffi::get_handle<NodeFactoryWrapper>(factory);
+        wrapper->factory->RegisterNodeClass<PassThroughNode>("Bench", kPassThroughClass);
+        wrapper->factory->RegisterNodeClass<MergeNode>("Bench", kMergeClass);
+    }
+
+    ~BenchEnv() {
+        flow_release_handle(factory);
+        flow_env_destroy(env);
+    }
+
+    BenchEnv(const BenchEnv&) = delete;
+    BenchEnv& operator=(const BenchEnv&) = delete;
+};
+
+// A graph of node_count pass-through nodes connected as a single chain
+struct ChainGraph {
+    FlowGraphHandle graph = nullptr;
+    std::vector<FlowNodeHandle> nodes;
+
+    ChainGraph(const BenchEnv& bench_env, size_t node_count) {
+        graph = flow_graph_create(bench_env.env);
+        nodes.reserve(node_count);
+        for (size_t i = 0; i < node_count; ++i) {
+            std::string name = "node" + std::to_string(i);
+            nodes.push_back(flow_graph_add_node(graph, kPassThroughClass, name.c_str()));
+            if (i > 0) {
+                auto connection = flow_graph_connect_nodes(graph, flow_node_get_id(nodes[i - 1]),
+                                                           "out", flow_node_get_id(nodes[i]), "in");
+                flow_release_handle(connection);
+            }
+        }
+    }
+
+    ~ChainGraph() {
+        for (auto node : nodes) {
+            flow_release_handle(node);
+        }
+        flow_graph_destroy(graph);
+    }
+
+    ChainGraph(const ChainGraph&) = delete;
+    ChainGraph& operator=(const ChainGraph&) = delete;
+};
+
+} // namespace flow_ffi_bench
@@ -0,0 +1,274 @@
+// Per-call cost of the exported C API
+//
+// Run with --benchmark_out=results.json --benchmark_out_format=json for machine-readable
+// output, and compare two result files with scripts/bench_compare.py.
+
+#include "flow_ffi.h"
+
+#include <cstdint>
+#include <string>
+
+#include "bench_nodes.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace flow_ffi_bench;
+
+namespace {
+
+// ============================================================================
+// Handles and errors
+// ============================================================================
+
+void BM_IsValidHandle(benchmark::State& state) {
+    BenchEnv bench_env;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flow_is_valid_handle(bench_env.env));
+    }
+}
+BENCHMARK(BM_IsValidHandle);
+
+void BM_RetainReleaseHandle(benchmark::State& state) {
+    BenchEnv bench_env;
+    for (auto _ : state) {
+        flow_retain_handle(bench_env.env);
+        flow_release_handle(bench_env.env);
+    }
+}
+BENCHMARK(BM_RetainReleaseHandle);
+
+void BM_InvalidHandleError(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flow_graph_run(nullptr));
+    }
+    flow_clear_error();
+}
+BENCHMARK(BM_InvalidHandleError);
+
+// ============================================================================
+// Data
+// ============================================================================
+
+void BM_DataCreateDestroyInt(benchmark::State& state) {
+    for (auto _ : state) {
+        FlowNodeDataHandle data = flow_data_create_int(42);
+        flow_data_destroy(data);
+    }
+}
+BENCHMARK(BM_DataCreateDestroyInt);
+
+void BM_DataCreateDestroyString(benchmark::State& state) {
+    std::string value(static_cast<size_t>(state.range(0)), 'x');
+    for (auto _ : state) {
+        FlowNodeDataHandle data = flow_data_create_string(value.c_str());
+        flow_data_destroy(data);
+    }
+}
+BENCHMARK(BM_DataCreateDestroyString)->Arg(8)->Arg(1024);
+
+void BM_DataGetInt(benchmark::State& state) {
+    FlowNodeDataHandle data = flow_data_create_int(42);
+    int32_t value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flow_data_get_int(data, &value));
+    }
+    flow_data_destroy(data);
+}
+BENCHMARK(BM_DataGetInt);
+
+void BM_DataGetString(benchmark::State& state) {
+    FlowNodeDataHandle data = flow_data_create_string("benchmark");
+    for (auto _ : state) {
+        char* value = nullptr;
+        benchmark::DoNotOptimize(flow_data_get_string(data, &value));
+        flow_free_string(value);
+    }
+    flow_data_destroy(data);
+}
+BENCHMARK(BM_DataGetString);
+
+// ============================================================================
+// Nodes
+// ============================================================================
+
+void BM_NodeSetInputData(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, 1);
+    FlowNodeDataHandle data = flow_data_create_int(7);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flow_node_set_input_data(chain.nodes[0], "in", data));
+    }
+    flow_data_destroy(data);
+    flow_env_wait(bench_env.env);
+}
+BENCHMARK(BM_NodeSetInputData);
+
+void BM_NodeGetOutputData(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, 1);
+    FlowNodeDataHandle data = flow_data_create_int(7);
+    flow_node_set_input_data(chain.nodes[0], "in", data);
+    flow_env_wait(bench_env.env);
+    for (auto _ : state) {
+        FlowNodeDataHandle output = flow_node_get_output_data(chain.nodes[0], "out");
+        flow_data_destroy(output);
+    }
+    flow_data_destroy(data);
+}
+BENCHMARK(BM_NodeGetOutputData);
+
+void BM_NodeGetName(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, 1);
+    for (auto _ : state) {
+        const char* name = flow_node_get_name(chain.nodes[0]);
+        flow_free_string(const_cast<char*>(name));
+    }
+}
+BENCHMARK(BM_NodeGetName);
+
+// ============================================================================
+// Graphs
+// ============================================================================
+
+void BM_GraphAddRemoveNode(benchmark::State& state) {
+    BenchEnv bench_env;
+    FlowGraphHandle graph = flow_graph_create(bench_env.env);
+    for (auto _ : state) {
+        FlowNodeHandle node = flow_graph_add_node(graph, kPassThroughClass, "node");
+        flow_graph_remove_node(graph, flow_node_get_id(node));
+        flow_release_handle(node);
+    }
+    flow_graph_destroy(graph);
+}
+BENCHMARK(BM_GraphAddRemoveNode);
+
+void BM_GraphConnectDisconnect(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, 2);
+    std::string source = flow_node_get_id(chain.nodes[0]);
+    std::string target = flow_node_get_id(chain.nodes[1]);
+
+    // Start from two unconnected nodes
+    FlowConnectionInfo* connections = nullptr;
+    size_t count = 0;
+    flow_graph_get_connections(chain.graph, &connections, &count);
+    for (size_t i = 0; i < count; ++i) {
+        flow_graph_disconnect_nodes(chain.graph, connections[i].id);
+    }
+    flow_free_connection_array(connections, count);
+
+    for (auto _ : state) {
+        FlowConnectionHandle connection =
+            flow_graph_connect_nodes(chain.graph, source.c_str(), "out", target.c_str(), "in");
+        std::string id = flow_connection_get_id(connection);
+        flow_release_handle(connection);
+        flow_graph_disconnect_nodes(chain.graph, id.c_str());
+    }
+}
+BENCHMARK(BM_GraphConnectDisconnect);
+
+void BM_GraphRunChain(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, static_cast<size_t>(state.range(0)));
+    FlowNodeDataHandle data = flow_data_create_int(1);
+    flow_node_set_input_data(chain.nodes[0], "in", data);
+    flow_env_wait(bench_env.env);
+    for (auto _ : state) {
+        flow_graph_run(chain.graph);
+        flow_env_wait(bench_env.env);
+    }
+    flow_data_destroy(data);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GraphRunChain)->Arg(1)->Arg(4)->Arg(16);
+
+// Parallel context run of a chain with fusion off (fused = 0) and on. Every node of a
+// fused chain runs in one task, so the scheduler is entered once instead of per node.
+void BM_ContextRunChain(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, static_cast<size_t>(state.range(0)));
+    flow_graph_set_fusion_threshold(chain.graph, state.range(1) ? UINT64_MAX : 0);
+    FlowContextHandle context = flow_graph_create_context(chain.graph);
+    flow_context_set_parallelism(context, 2);
+    FlowNodeDataHandle data = flow_data_create_int(1);
+    flow_context_set_input(context, flow_node_get_id(chain.nodes[0]), "in", data);
+    for (auto _ : state) {
+        flow_context_run(context);
+    }
+    FlowRunStats stats{};
+    flow_context_get_run_stats(context, &stats);
+    state.counters["tasks"] = static_cast<double>(stats.tasks_scheduled);
+    flow_data_destroy(data);
+    flow_context_destroy(context);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ContextRunChain)->ArgNames({"nodes", "fused"})->ArgsProduct({{16, 256}, {0, 1}});
+
+void BM_GraphGetNodes(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        FlowNodeHandle* nodes = nullptr;
+        size_t count = 0;
+        flow_graph_get_nodes(chain.graph, &nodes, &count);
+        for (size_t i = 0; i < count; ++i) {
+            flow_release_handle(nodes[i]);
+        }
+        flow_free_handle_array(reinterpret_cast<void**>(nodes));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GraphGetNodes)->Arg(16)->Arg(1024);
+
+// ============================================================================
+// Serialization on synthetic graphs
+// ============================================================================
+
+void BM_GraphSaveToJson(benchmark::State& state) {
+    BenchEnv bench_env;
+    ChainGraph chain(bench_env, static_cast<size_t>(state.range(0)));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        char* json = flow_graph_save_to_json(chain.graph);
+        bytes = std::char_traits<char>::length(json);
+        flow_free_string(json);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GraphSaveToJson)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_GraphLoadFromJson(benchmark::State& state) {
+    BenchEnv bench_env;
+    std::string json;
+    {
+        ChainGraph chain(bench_env, static_cast<size_t>(state.range(0)));
+        char* saved = flow_graph_save_to_json(chain.graph);
+        json = saved;
+        flow_free_string(saved);
+    }
+
+    FlowGraphHandle graph = flow_graph_create(bench_env.env);
+    for (auto _ : state) {
+        flow_graph_load_from_json(graph, json.c_str());
+        state.PauseTiming();
+        flow_graph_clear(graph);
+        state.ResumeTiming();
+    }
+    flow_graph_destroy(graph);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GraphLoadFromJson)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,171 @@
+// Contention on the global HandleRegistry and ErrorManager locks, from 1 to 64 threads
+//
+// Every benchmark reports aggregate ops/sec (items_per_second) and the per-thread p50 and
+// p99 latency of a single operation, averaged over threads, so a regression in the
+// locking design shows up both as lost throughput and as a longer tail.
+
+#include "flow_ffi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "handle_manager.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Per-thread latency samples of the timed operation
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(benchmark::State& state) : state_(state) {
+        samples_.reserve(std::min<benchmark::IterationCount>(state.max_iterations, 1 << 22));
+    }
+
+    template <typename F>
+    void time(F&& op) {
+        auto start = Clock::now();
+        op();
+        auto elapsed = Clock::now() - start;
+        samples_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ~LatencyRecorder() {
+        if (samples_.empty()) {
+            return;
+        }
+        std::sort(samples_.begin(), samples_.end());
+        auto percentile = [&](double p) {
+            return static_cast<double>(samples_[static_cast<size_t>(p * (samples_.size() - 1))]);
+        };
+        state_.counters["p50_ns"] =
+            benchmark::Counter(percentile(0.50), benchmark::Counter::kAvgThreads);
+        state_.counters["p99_ns"] =
+            benchmark::Counter(percentile(0.99), benchmark::Counter::kAvgThreads);
+        state_.SetItemsProcessed(state_.iterations());
+    }
+
+private:
+    benchmark::State& state_;
+    std::vector<int64_t> samples_;
+};
+
+// A handle every thread reads, created once for the whole run
+void* shared_handle() {
+    static void* handle = flow_ffi::create_handle<int>(42);
+    return handle;
+}
+
+// ============================================================================
+// HandleRegistry
+// ============================================================================
+
+void BM_HandleCreateGetRelease(benchmark::State& state) {
+    LatencyRecorder latency(state);
+    int value = 0;
+    for (auto _ : state) {
+        latency.time([&] {
+            void* handle = flow_ffi::create_handle<int>(value++);
+            benchmark::DoNotOptimize(flow_ffi::get_handle<int>(handle));
+            flow_ffi::release_handle(handle);
+        });
+    }
+}
+BENCHMARK(BM_HandleCreateGetRelease)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_HandleValidate(benchmark::State& state) {
+    void* handle = shared_handle();
+    LatencyRecorder latency(state);
+    for (auto _ : state) {
+        latency.time([&] { benchmark::DoNotOptimize(flow_ffi::validate_handle(handle, "h")); });
+    }
+}
+BENCHMARK(BM_HandleValidate)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_HandleRetainRelease(benchmark::State& state) {
+    void* handle = shared_handle();
+    LatencyRecorder latency(state);
+    for (auto _ : state) {
+        latency.time([&] {
+            flow_ffi::retain_handle(handle);
+            flow_ffi::release_handle(handle);
+        });
+    }
+}
+BENCHMARK(BM_HandleRetainRelease)->ThreadRange(1, 64)->UseRealTime();
+
+// ============================================================================
+// ErrorManager
+// ============================================================================
+
+void BM_ErrorSetClear(benchmark::State& state) {
+    auto& errors = flow_ffi::ErrorManager::instance();
+    LatencyRecorder latency(state);
+    for (auto _ : state) {
+        latency.time([&] {
+            errors.set_error(FLOW_ERROR_INVALID_ARGUMENT, "Invalid argument: bench");
+            errors.clear_error();
+        });
+    }
+}
+BENCHMARK(BM_ErrorSetClear)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_ErrorGetLast(benchmark::State& state) {
+    auto& errors = flow_ffi::ErrorManager::instance();
+    errors.set_error(FLOW_ERROR_INVALID_ARGUMENT, "Invalid argument: bench");
+    LatencyRecorder latency(state);
+    for (auto _ : state) {
+        latency.time([&] { benchmark::DoNotOptimize(errors.get_last_error_code()); });
+    }
+    errors.clear_error();
+}
+BENCHMARK(BM_ErrorGetLast)->ThreadRange(1, 64)->UseRealTime();
+
+// ============================================================================
+// Mixed workload
+// ============================================================================
+
+// Roughly what a bridge call sequence does: mostly lookups and validation, some handle
+// churn, and the occasional error set, read and cleared
+void BM_MixedWorkload(benchmark::State& state) {
+    auto& errors = flow_ffi::ErrorManager::instance();
+    void* shared = shared_handle();
+    LatencyRecorder latency(state);
+    uint32_t step = 0;
+    for (auto _ : state) {
+        latency.time([&] {
+            switch (step++ % 10) {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+                benchmark::DoNotOptimize(flow_ffi::validate_handle(shared, "h"));
+                break;
+            case 4:
+            case 5:
+            case 6:
+                benchmark::DoNotOptimize(flow_ffi::get_handle<int>(shared));
+                break;
+            case 7: {
+                void* handle = flow_ffi::create_handle<int>(static_cast<int>(step));
+                flow_ffi::release_handle(handle);
+                break;
+            }
+            case 8:
+                errors.set_error(FLOW_ERROR_NODE_NOT_FOUND, "Node not found");
+                break;
+            default:
+                benchmark::DoNotOptimize(errors.get_last_error_code());
+                errors.clear_error();
+                break;
+            }
+        });
+    }
+}
+BENCHMARK(BM_MixedWorkload)->ThreadRange(1, 64)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,204 @@
+// How graph construction, connection, execution, queries and serialization scale with
+// graph size, on synthetic chains, fan-outs, random DAGs and layered graphs
+//
+// Every benchmark runs from 1k to 1M nodes per shape and reports a fitted complexity,
+// plus graph_rss, how much the resident set grew while its graph was built (0 where the
+// platform does not report it). Use --benchmark_filter to restrict shapes or sizes, e.g.
+// --benchmark_filter='chain/.*'.
+
+#include "flow_ffi.h"
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "graph_generator.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace flow_ffi_bench;
+
+namespace {
+
+void set_scaling_counters(benchmark::State& state, const GraphSpec& spec, size_t graph_bytes) {
+    state.SetComplexityN(static_cast<int64_t>(spec.node_count));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(spec.node_count));
+    state.counters["edges"] = static_cast<double>(spec.edges.size());
+    state.counters["graph_rss"] = benchmark::Counter(static_cast<double>(graph_bytes),
+                                                     benchmark::Counter::kDefaults,
+                                                     benchmark::Counter::kIs1024);
+}
+
+void BM_AddNodes(benchmark::State& state, GraphShape shape) {
+    BenchEnv bench_env;
+    auto spec = generate_graph(shape, static_cast<size_t>(state.range(0)));
+    std::optional<size_t> graph_bytes; // Measured on the first iteration only
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            std::optional<RssDelta> rss;
+            if (!graph_bytes) {
+                rss.emplace();
+            }
+            SyntheticGraph synthetic(bench_env);
+            state.ResumeTiming();
+            synthetic.add_nodes(spec);
+            state.PauseTiming();
+            if (rss) {
+                graph_bytes = rss->read();
+            }
+        }
+        state.ResumeTiming();
+    }
+    set_scaling_counters(state, spec, graph_bytes.value_or(0));
+}
+
+void BM_Connect(benchmark::State& state, GraphShape shape) {
+    BenchEnv bench_env;
+    auto spec = generate_graph(shape, static_cast<size_t>(state.range(0)));
+    std::optional<size_t> graph_bytes; // Measured on the first iteration only
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            std::optional<RssDelta> rss;
+            if (!graph_bytes) {
+                rss.emplace();
+            }
+            SyntheticGraph synthetic(bench_env);
+            synthetic.add_nodes(spec);
+            state.ResumeTiming();
+            synthetic.connect(spec);
+            state.PauseTiming();
+            if (rss) {
+                graph_bytes = rss->read();
+            }
+        }
+        state.ResumeTiming();
+    }
+    set_scaling_counters(state, spec, graph_bytes.value_or(0));
+}
+
+void BM_Run(benchmark::State& state, GraphShape shape) {
+    BenchEnv bench_env;
+    auto spec = generate_graph(shape, static_cast<size_t>(state.range(0)));
+    RssDelta rss;
+    SyntheticGraph synthetic(bench_env);
+    synthetic.add_nodes(spec);
+    synthetic.connect(spec);
+    FlowNodeDataHandle data = flow_data_create_int(1);
+    synthetic.seed_roots(spec, data);
+    flow_env_wait(bench_env.env);
+    const size_t graph_bytes = rss.read();
+    for (auto _ : state) {
+        flow_graph_run(synthetic.graph);
+        flow_env_wait(bench_env.env);
+    }
+    flow_data_destroy(data);
+    set_scaling_counters(state, spec, graph_bytes);
+}
+
+void BM_Query(benchmark::State& state, GraphShape shape) {
+    BenchEnv bench_env;
+    auto spec = generate_graph(shape, static_cast<size_t>(state.range(0)));
+    RssDelta rss;
+    SyntheticGraph synthetic(bench_env);
+    synthetic.add_nodes(spec);
+    synthetic.connect(spec);
+    const size_t graph_bytes = rss.read();
+    for (auto _ : state) {
+        FlowNodeHandle* nodes = nullptr;
+        size_t node_count = 0;
+        flow_graph_get_nodes(synthetic.graph, &nodes, &node_count);
+        for (size_t i = 0; i < node_count; ++i) {
+            flow_release_handle(nodes[i]);
+        }
+        flow_free_handle_array(reinterpret_cast<void**>(nodes));
+
+        FlowConnectionInfo* connections = nullptr;
+        size_t connection_count = 0;
+        flow_graph_get_connections(synthetic.graph, &connections, &connection_count);
+        flow_free_connection_array(connections, connection_count);
+    }
+    set_scaling_counters(state, spec, graph_bytes);
+}
+
+void BM_SaveToJson(benchmark::State& state, GraphShape shape) {
+    BenchEnv bench_env;
+    auto spec = generate_graph(shape, static_cast<size_t>(state.range(0)));
+    RssDelta rss;
+    SyntheticGraph synthetic(bench_env);
+    synthetic.add_nodes(spec);
+    synthetic.connect(spec);
+    const size_t graph_bytes = rss.read();
+    size_t bytes = 0;
+    for (auto _ : state) {
+        char* json = flow_graph_save_to_json(synthetic.graph);
+        bytes = std::char_traits<char>::length(json);
+        flow_free_string(json);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    set_scaling_counters(state, spec, graph_bytes);
+}
+
+void BM_LoadFromJson(benchmark::State& state, GraphShape shape) {
+    BenchEnv bench_env;
+    auto spec = generate_graph(shape, static_cast<size_t>(state.range(0)));
+    std::string json;
+    size_t graph_bytes = 0; // The graph loading builds, measured on the original
+    {
+        RssDelta rss;
+        SyntheticGraph synthetic(bench_env);
+        synthetic.add_nodes(spec);
+        synthetic.connect(spec);
+        graph_bytes = rss.read();
+        char* saved = flow_graph_save_to_json(synthetic.graph);
+        json = saved;
+        flow_free_string(saved);
+    }
+
+    FlowGraphHandle graph = flow_graph_create(bench_env.env);
+    for (auto _ : state) {
+        flow_graph_load_from_json(graph, json.c_str());
+        state.PauseTiming();
+        flow_graph_clear(graph);
+        state.ResumeTiming();
+    }
+    flow_graph_destroy(graph);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+    set_scaling_counters(state, spec, graph_bytes);
+}
+
+void register_scaling_benchmarks() {
+    using Function = void (*)(benchmark::State&, GraphShape);
+    const std::pair<const char*, Function> phases[] = {
+        {"add_nodes", BM_AddNodes},     {"connect", BM_Connect},
+        {"run", BM_Run},                {"query", BM_Query},
+        {"save_json", BM_SaveToJson},   {"load_json", BM_LoadFromJson},
+    };
+    const GraphShape shapes[] = {GraphShape::Chain, GraphShape::FanOut, GraphShape::RandomDag,
+                                 GraphShape::Layered};
+
+    // One family per shape and phase so each gets its own complexity fit
+    for (auto shape : shapes) {
+        for (const auto& [phase, function] : phases) {
+            std::string name = std::string(shape_name(shape)) + "/" + phase;
+            benchmark::RegisterBenchmark(name.c_str(), function, shape)
+                ->RangeMultiplier(10)
+                ->Range(1000, 1000000)
+                ->Unit(benchmark::kMillisecond)
+                ->Complexity();
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    register_scaling_benchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
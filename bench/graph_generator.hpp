@@ -0,0 +1,205 @@
+#pragma once
+
+#include "flow_ffi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_nodes.hpp"
+
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+// Parameterized synthetic graphs of bench.Merge nodes for the scaling benchmarks.
+// The topology is planned up front so building it can be timed apart from planning.
+
+namespace flow_ffi_bench {
+
+enum class GraphShape { Chain, FanOut, RandomDag, Layered };
+
+inline const char* shape_name(GraphShape shape) {
+    switch (shape) {
+    case GraphShape::Chain:
+        return "chain";
+    case GraphShape::FanOut:
+        return "fanout";
+    case GraphShape::RandomDag:
+        return "random_dag";
+    case GraphShape::Layered:
+        return "layered";
+    }
+    return "unknown";
+}
+
+struct GraphEdge {
+    size_t source;
+    size_t target;
+    const char* target_port;
+};
+
+struct GraphSpec {
+    size_t node_count = 0;
+    std::vector<GraphEdge> edges;
+    std::vector<size_t> roots; // Nodes without incoming edges
+};
+
+// Every node gets at most one edge per input port, and edges always point from a lower
+// to a higher index so the result is acyclic
+inline GraphSpec generate_graph(GraphShape shape, size_t node_count, uint32_t seed = 42) {
+    GraphSpec spec;
+    spec.node_count = node_count;
+    spec.edges.reserve(node_count * 2);
+    if (node_count == 0) {
+        return spec;
+    }
+
+    switch (shape) {
+    case GraphShape::Chain:
+        for (size_t i = 1; i < node_count; ++i) {
+            spec.edges.push_back({i - 1, i, "a"});
+        }
+        spec.roots.push_back(0);
+        break;
+
+    case GraphShape::FanOut:
+        for (size_t i = 1; i < node_count; ++i) {
+            spec.edges.push_back({0, i, "a"});
+        }
+        spec.roots.push_back(0);
+        break;
+
+    case GraphShape::RandomDag: {
+        std::mt19937 rng(seed);
+        for (size_t i = 1; i < node_count; ++i) {
+            std::uniform_int_distribution<size_t> pick(0, i - 1);
+            size_t first = pick(rng);
+            spec.edges.push_back({first, i, "a"});
+            if (i > 1 && (rng() & 1)) {
+                size_t second = pick(rng);
+                if (second != first) {
+                    spec.edges.push_back({second, i, "b"});
+                }
+            }
+        }
+        spec.roots.push_back(0);
+        break;
+    }
+
+    case GraphShape::Layered: {
+        // Roughly square: sqrt(n) layers of sqrt(n) nodes, each fed by two nodes of the
+        // layer above
+        size_t width = std::max<size_t>(1, static_cast<size_t>(std::sqrt(node_count)));
+        for (size_t i = 0; i < node_count; ++i) {
+            if (i < width) {
+                spec.roots.push_back(i);
+                continue;
+            }
+            size_t above = i - width;
+            size_t layer_start = above - above % width;
+            spec.edges.push_back({above, i, "a"});
+            if (width > 1) {
+                spec.edges.push_back({layer_start + (above - layer_start + 1) % width, i, "b"});
+            }
+        }
+        break;
+    }
+    }
+    return spec;
+}
+
+// A graph built from a GraphSpec through the C API, in two separately timeable steps
+struct SyntheticGraph {
+    FlowGraphHandle graph = nullptr;
+    std::vector<FlowNodeHandle> nodes;
+
+    explicit SyntheticGraph(const BenchEnv& bench_env) { graph = flow_graph_create(bench_env.env); }
+
+    void add_nodes(const GraphSpec& spec) {
+        nodes.reserve(spec.node_count);
+        for (size_t i = 0; i < spec.node_count; ++i) {
+            std::string name = "n" + std::to_string(i);
+            nodes.push_back(flow_graph_add_node(graph, kMergeClass, name.c_str()));
+        }
+    }
+
+    void connect(const GraphSpec& spec) {
+        for (const auto& edge : spec.edges) {
+            auto connection =
+                flow_graph_connect_nodes(graph, flow_node_get_id(nodes[edge.source]), "out",
+                                         flow_node_get_id(nodes[edge.target]), edge.target_port);
+            flow_release_handle(connection);
+        }
+    }
+
+    void seed_roots(const GraphSpec& spec, FlowNodeDataHandle data) {
+        for (size_t root : spec.roots) {
+            flow_node_set_input_data(nodes[root], "a", data);
+        }
+    }
+
+    ~SyntheticGraph() {
+        for (auto node : nodes) {
+            flow_release_handle(node);
+        }
+        flow_graph_destroy(graph);
+    }
+
+    SyntheticGraph(const SyntheticGraph&) = delete;
+    SyntheticGraph& operator=(const SyntheticGraph&) = delete;
+};
+
+// Resident set size of the process right now, or 0 where unavailable. Free heap memory is
+// handed back to the system first where the allocator supports it, so memory released by
+// earlier benchmarks is not silently reused between two readings.
+inline size_t current_rss_bytes() {
+#if defined(__linux__)
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<size_t>(info.resident_size);
+#else
+    return 0;
+#endif
+}
+
+// Growth of the resident set between construction and read(), which attributes memory to
+// what one benchmark built rather than to the whole process
+class RssDelta {
+public:
+    RssDelta() : start_(current_rss_bytes()) {}
+
+    size_t read() const {
+        size_t now = current_rss_bytes();
+        return now > start_ ? now - start_ : 0;
+    }
+
+private:
+    size_t start_;
+};
+
+} // namespace flow_ffi_bench
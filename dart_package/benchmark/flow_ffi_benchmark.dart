@@ -0,0 +1,361 @@
+/// End-to-end FFI round-trip benchmarks, measured from Dart.
+///
+/// These cover what the C++ `flow_ffi_bench` suite cannot see: string
+/// marshaling, wrapper objects and their finalizers, and event callbacks
+/// crossing back into Dart.
+///
+/// Usage (from `dart_package/`, with `libflow_ffi` built in `../build`):
+///
+///   dart run benchmark/flow_ffi_benchmark.dart [--json=results.json]
+///       [--filter=REGEX] [--min-time=SECONDS]
+///
+/// Benchmarks that need a node class use `FLOW_BENCH_NODE_CLASS` (with int
+/// ports named by `FLOW_BENCH_INPUT_PORT` / `FLOW_BENCH_OUTPUT_PORT`,
+/// default `in` / `out`), optionally loaded from the module at
+/// `FLOW_BENCH_MODULE`. They are skipped when no such class is registered.
+library;
+
+import 'dart:async';
+import 'dart:ffi';
+import 'dart:io';
+
+import 'package:ffi/ffi.dart';
+import 'package:flow_ffi/flow_ffi.dart';
+import 'package:flow_ffi/src/ffi/bindings.dart';
+
+import 'harness.dart';
+
+/// Node class and ports used by the node benchmarks.
+class NodeConfig {
+  NodeConfig.fromEnvironment()
+      : classId = Platform.environment['FLOW_BENCH_NODE_CLASS'] ?? '',
+        inputPort = Platform.environment['FLOW_BENCH_INPUT_PORT'] ?? 'in',
+        outputPort = Platform.environment['FLOW_BENCH_OUTPUT_PORT'] ?? 'out',
+        modulePath = Platform.environment['FLOW_BENCH_MODULE'];
+
+  final String classId;
+  final String inputPort;
+  final String outputPort;
+  final String? modulePath;
+}
+
+// ============================================================================
+// Handles and data
+// ============================================================================
+
+class DataCreateDestroyInt extends FfiBenchmark {
+  DataCreateDestroyInt() : super('DataCreateDestroyInt');
+
+  @override
+  void run() {
+    final data = flowCore.native.flow_data_create_int(42);
+    flowCore.native.flow_data_destroy(data);
+  }
+}
+
+/// Dart string -> native data -> Dart string, including both conversions.
+class DataStringRoundTrip extends FfiBenchmark {
+  DataStringRoundTrip(int length)
+      : _value = 'x' * length,
+        super('DataStringRoundTrip/$length');
+
+  final String _value;
+  late final Pointer<Pointer<Char>> _out;
+
+  @override
+  void setUp() {
+    _out = calloc<Pointer<Char>>();
+  }
+
+  @override
+  void tearDown() {
+    calloc.free(_out);
+  }
+
+  @override
+  void run() {
+    final native = _value.toNativeUtf8();
+    final data = flowCore.native.flow_data_create_string(native.cast<Char>());
+    calloc.free(native);
+
+    flowCore.native.flow_data_get_string(data, _out);
+    _out.value.cast<Utf8>().toDartString();
+    flowCore.native.flow_free_string(_out.value);
+    flowCore.native.flow_data_destroy(data);
+  }
+}
+
+class EnvironmentCreateDispose extends FfiBenchmark {
+  EnvironmentCreateDispose() : super('EnvironmentCreateDispose');
+
+  @override
+  void run() {
+    Environment(maxThreads: 1).dispose();
+  }
+}
+
+class GraphCreateDispose extends FfiBenchmark {
+  GraphCreateDispose(this._env) : super('GraphCreateDispose');
+
+  final Environment _env;
+
+  @override
+  void run() {
+    Graph(_env).dispose();
+  }
+}
+
+// ============================================================================
+// Nodes
+// ============================================================================
+
+/// Scalar input set, compute and output read on a single node.
+class NodeSetComputeGet extends FfiBenchmark {
+  NodeSetComputeGet(this._env, this._config) : super('NodeSetComputeGet');
+
+  final Environment _env;
+  final NodeConfig _config;
+  late final Graph _graph;
+  late final Node _node;
+  var _value = 0;
+
+  @override
+  void setUp() {
+    _graph = Graph(_env);
+    _node = _graph.addNode(_config.classId, 'node');
+  }
+
+  @override
+  void tearDown() {
+    _node.dispose();
+    _graph.dispose();
+  }
+
+  @override
+  void run() {
+    _node.setInputData(_config.inputPort, _value++);
+    _node.compute();
+    _node.getOutputData<int>(_config.outputPort);
+  }
+}
+
+/// Time from adding a node until the `onNodeAdded` event reaches a listener.
+class EventNodeAddedLatency extends AsyncFfiBenchmark {
+  EventNodeAddedLatency(this._env, this._config)
+      : super('EventNodeAddedLatency');
+
+  final Environment _env;
+  final NodeConfig _config;
+  late final Graph _graph;
+  late final StreamSubscription<NodeEventData> _subscription;
+  Completer<void>? _pending;
+
+  @override
+  Future<void> setUp() async {
+    _graph = Graph(_env);
+    _subscription = _graph.onNodeAdded.listen((_) => _pending?.complete());
+  }
+
+  @override
+  Future<void> tearDown() async {
+    await _subscription.cancel();
+    _graph.dispose();
+  }
+
+  @override
+  Future<int> run() async {
+    final pending = _pending = Completer<void>();
+    final stopwatch = Stopwatch()..start();
+    final node = _graph.addNode(_config.classId, 'node');
+    await pending.future;
+    stopwatch.stop();
+
+    _pending = null;
+    _graph.removeNode(node.id);
+    node.dispose();
+    return elapsedNs(stopwatch);
+  }
+}
+
+// ============================================================================
+// Graph building and serialization
+// ============================================================================
+
+/// Builds a connected chain through the [GraphBuilder] service.
+class GraphBuilderChain extends FfiBenchmark {
+  GraphBuilderChain(this._env, this._config, this._length)
+      : super('GraphBuilderChain/$_length');
+
+  final Environment _env;
+  final NodeConfig _config;
+  final int _length;
+
+  @override
+  void run() {
+    final graph = Graph(_env);
+    final builder = buildChain(graph, _config, _length);
+    for (final node in builder.nodes.values) {
+      node.dispose();
+    }
+    graph.dispose();
+  }
+}
+
+class GraphSaveToJson extends FfiBenchmark {
+  GraphSaveToJson(this._env, this._config, this._length)
+      : super('GraphSaveToJson/$_length');
+
+  final Environment _env;
+  final NodeConfig _config;
+  final int _length;
+  late final Graph _graph;
+
+  @override
+  void setUp() {
+    _graph = Graph(_env);
+    for (final node in buildChain(_graph, _config, _length).nodes.values) {
+      node.dispose();
+    }
+  }
+
+  @override
+  void tearDown() {
+    _graph.dispose();
+  }
+
+  @override
+  void run() {
+    _graph.saveToJson();
+  }
+}
+
+/// Loads a saved chain into a fresh graph; includes creating the graph.
+class GraphLoadFromJson extends FfiBenchmark {
+  GraphLoadFromJson(this._env, this._config, this._length)
+      : super('GraphLoadFromJson/$_length');
+
+  final Environment _env;
+  final NodeConfig _config;
+  final int _length;
+  late final String _json;
+
+  @override
+  void setUp() {
+    final graph = Graph(_env);
+    for (final node in buildChain(graph, _config, _length).nodes.values) {
+      node.dispose();
+    }
+    _json = graph.saveToJson();
+    graph.dispose();
+  }
+
+  @override
+  void run() {
+    final graph = Graph(_env);
+    graph.loadFromJson(_json);
+    graph.dispose();
+  }
+}
+
+GraphBuilder buildChain(Graph graph, NodeConfig config, int length) {
+  final builder = GraphBuilder(graph);
+  for (var i = 0; i < length; i++) {
+    builder.addNode('n$i', config.classId);
+    if (i > 0) {
+      builder.connect(
+          'n${i - 1}', config.outputPort, 'n$i', config.inputPort);
+    }
+  }
+  return builder;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+Future<bool> _nodeClassAvailable(Environment env, NodeConfig config) async {
+  if (config.modulePath != null) {
+    final module = Module(env.factory);
+    if (!await module.load(config.modulePath!)) {
+      stderr.writeln('Failed to load module ${config.modulePath}');
+      return false;
+    }
+    module.registerNodes();
+  }
+
+  if (config.classId.isEmpty) {
+    return false;
+  }
+
+  final graph = Graph(env);
+  try {
+    graph.addNode(config.classId, 'probe').dispose();
+    return true;
+  } on FlowException {
+    ErrorHandler.clearError();
+    return false;
+  } finally {
+    graph.dispose();
+  }
+}
+
+String? _option(List<String> args, String name) {
+  final prefix = '--$name=';
+  for (final arg in args) {
+    if (arg.startsWith(prefix)) {
+      return arg.substring(prefix.length);
+    }
+  }
+  return null;
+}
+
+Future<void> main(List<String> args) async {
+  final filter = _option(args, 'filter');
+  final minTime = double.tryParse(_option(args, 'min-time') ?? '') ?? 0.5;
+  final runner = BenchmarkRunner(
+    minTime: Duration(microseconds: (minTime * 1e6).round()),
+    filter: filter == null ? null : RegExp(filter),
+  );
+
+  final env = Environment(maxThreads: 1);
+  final config = NodeConfig.fromEnvironment();
+  final haveNodes = await _nodeClassAvailable(env, config);
+
+  runner.printHeader();
+  runner.measure(DataCreateDestroyInt());
+  runner.measure(DataStringRoundTrip(8));
+  runner.measure(DataStringRoundTrip(1024));
+  runner.measure(EnvironmentCreateDispose());
+  runner.measure(GraphCreateDispose(env));
+
+  final nodeBenchmarks = [
+    'NodeSetComputeGet',
+    'EventNodeAddedLatency',
+    for (final length in [16, 256]) ...[
+      'GraphBuilderChain/$length',
+      'GraphSaveToJson/$length',
+      'GraphLoadFromJson/$length',
+    ],
+  ];
+  if (haveNodes) {
+    runner.measure(NodeSetComputeGet(env, config));
+    await runner.measureAsync(EventNodeAddedLatency(env, config));
+    for (final length in [16, 256]) {
+      runner.measure(GraphBuilderChain(env, config, length));
+      runner.measure(GraphSaveToJson(env, config, length));
+      runner.measure(GraphLoadFromJson(env, config, length));
+    }
+  } else {
+    for (final name in nodeBenchmarks) {
+      runner.skip(name, 'set FLOW_BENCH_NODE_CLASS to a registered class');
+    }
+  }
+
+  env.dispose();
+
+  final jsonPath = _option(args, 'json');
+  if (jsonPath != null) {
+    runner.writeJson(jsonPath);
+    stdout.writeln('\nResults written to $jsonPath');
+  }
+}
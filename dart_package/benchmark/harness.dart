@@ -0,0 +1,195 @@
+/// Minimal timing harness for the Dart-side FFI benchmarks.
+///
+/// Results are written in the Google Benchmark JSON layout so
+/// `scripts/bench_compare.py` can compare Dart runs exactly like the C++
+/// `flow_ffi_bench` results.
+library;
+
+import 'dart:convert';
+import 'dart:io';
+
+/// A benchmark whose operation completes synchronously.
+abstract class FfiBenchmark {
+  FfiBenchmark(this.name);
+
+  /// Name reported in the results, e.g. `DataCreateDestroyInt`.
+  final String name;
+
+  /// Called once before timing starts.
+  void setUp() {}
+
+  /// Called once after timing ends.
+  void tearDown() {}
+
+  /// One operation; called in a tight loop.
+  void run();
+}
+
+/// A benchmark whose operation has to wait for the event loop.
+///
+/// [run] returns the nanoseconds to attribute to the operation, so cleanup
+/// done inside the same call is not counted.
+abstract class AsyncFfiBenchmark {
+  AsyncFfiBenchmark(this.name);
+
+  final String name;
+
+  Future<void> setUp() async {}
+
+  Future<void> tearDown() async {}
+
+  Future<int> run();
+}
+
+/// Timing of a single benchmark.
+class BenchmarkResult {
+  const BenchmarkResult(this.name, this.iterations, this.totalNs);
+
+  final String name;
+  final int iterations;
+  final int totalNs;
+
+  double get nsPerOp => totalNs / iterations;
+
+  Map<String, dynamic> toJson() => {
+        'name': name,
+        'run_name': name,
+        'run_type': 'iteration',
+        'iterations': iterations,
+        'real_time': nsPerOp,
+        'cpu_time': nsPerOp,
+        'time_unit': 'ns',
+      };
+
+  @override
+  String toString() =>
+      '${name.padRight(40)} ${_formatNs(nsPerOp).padLeft(12)} '
+      '${iterations.toString().padLeft(10)}';
+}
+
+/// Runs benchmarks until each has been timed for at least [minTime].
+class BenchmarkRunner {
+  BenchmarkRunner({
+    this.minTime = const Duration(milliseconds: 500),
+    this.filter,
+  });
+
+  final Duration minTime;
+  final RegExp? filter;
+  final List<BenchmarkResult> results = [];
+
+  static const Duration _warmupTime = Duration(milliseconds: 100);
+
+  bool _selected(String name) => filter == null || filter!.hasMatch(name);
+
+  void measure(FfiBenchmark benchmark) {
+    if (!_selected(benchmark.name)) {
+      return;
+    }
+
+    benchmark.setUp();
+    try {
+      _timeBatches(benchmark.run, _warmupTime);
+
+      // Grow the batch until one batch alone covers minTime, like Google
+      // Benchmark does, so the stopwatch overhead is amortized
+      var iterations = 1;
+      var totalNs = 0;
+      while (true) {
+        totalNs = _timeLoop(benchmark.run, iterations);
+        if (totalNs >= minTime.inMicroseconds * 1000) {
+          break;
+        }
+        iterations *= 2;
+      }
+      _report(BenchmarkResult(benchmark.name, iterations, totalNs));
+    } finally {
+      benchmark.tearDown();
+    }
+  }
+
+  Future<void> measureAsync(AsyncFfiBenchmark benchmark) async {
+    if (!_selected(benchmark.name)) {
+      return;
+    }
+
+    await benchmark.setUp();
+    try {
+      final warmup = Stopwatch()..start();
+      while (warmup.elapsed < _warmupTime) {
+        await benchmark.run();
+      }
+
+      final wall = Stopwatch()..start();
+      var iterations = 0;
+      var totalNs = 0;
+      while (wall.elapsed < minTime) {
+        totalNs += await benchmark.run();
+        iterations++;
+      }
+      _report(BenchmarkResult(benchmark.name, iterations, totalNs));
+    } finally {
+      await benchmark.tearDown();
+    }
+  }
+
+  /// Reports a benchmark that could not run, without failing the suite.
+  void skip(String name, String reason) {
+    if (_selected(name)) {
+      stdout.writeln('${name.padRight(40)} skipped: $reason');
+    }
+  }
+
+  void printHeader() {
+    stdout.writeln('${'Benchmark'.padRight(40)} ${'Time'.padLeft(12)} '
+        '${'Iterations'.padLeft(10)}');
+    stdout.writeln('-' * 64);
+  }
+
+  /// Writes all results to [path] as Google Benchmark JSON.
+  void writeJson(String path) {
+    final report = {
+      'context': {
+        'date': DateTime.now().toIso8601String(),
+        'executable': Platform.script.toFilePath(),
+        'dart_version': Platform.version,
+        'num_cpus': Platform.numberOfProcessors,
+      },
+      'benchmarks': [for (final result in results) result.toJson()],
+    };
+    File(path).writeAsStringSync(
+        const JsonEncoder.withIndent('  ').convert(report));
+  }
+
+  void _report(BenchmarkResult result) {
+    results.add(result);
+    stdout.writeln(result);
+  }
+
+  static void _timeBatches(void Function() body, Duration duration) {
+    final stopwatch = Stopwatch()..start();
+    while (stopwatch.elapsed < duration) {
+      _timeLoop(body, 100);
+    }
+  }
+
+  static int _timeLoop(void Function() body, int iterations) {
+    final stopwatch = Stopwatch()..start();
+    for (var i = 0; i < iterations; i++) {
+      body();
+    }
+    stopwatch.stop();
+    return elapsedNs(stopwatch);
+  }
+}
+
+/// Elapsed time of [stopwatch] in nanoseconds, at the platform resolution.
+int elapsedNs(Stopwatch stopwatch) =>
+    stopwatch.elapsedTicks * 1000000000 ~/ stopwatch.frequency;
+
+String _formatNs(double ns) {
+  if (ns >= 1e9) return '${(ns / 1e9).toStringAsFixed(2)} s';
+  if (ns >= 1e6) return '${(ns / 1e6).toStringAsFixed(2)} ms';
+  if (ns >= 1e3) return '${(ns / 1e3).toStringAsFixed(2)} us';
+  return '${ns.toStringAsFixed(1)} ns';
+}
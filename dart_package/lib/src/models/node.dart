@@ -120,9 +120,8 @@ class Node {
       throw const InvalidHandleException('Failed to get node ID');
     }
 
-    final result = resultPtr.cast<Utf8>().toDartString();
-    flowCore.flow_free_string(resultPtr);
-    return result;
+    // Owned by the node handle, not freed
+    return resultPtr.cast<Utf8>().toDartString();
   }
 
   /// Gets the friendly name of this node.
@@ -175,9 +174,8 @@ class Node {
       throw const InvalidHandleException('Failed to get node class');
     }
 
-    final result = resultPtr.cast<Utf8>().toDartString();
-    flowCore.flow_free_string(resultPtr);
-    return result;
+    // Interned by the library, not freed
+    return resultPtr.cast<Utf8>().toDartString();
   }
 
   /// Triggers computation for this node.
@@ -435,17 +433,9 @@ class Node {
 
       return keys;
     } finally {
-      // Clean up allocated memory
-      final count = countPtr.value;
-      if (count > 0 && keysPtr.value != nullptr) {
-        final keysArray = keysPtr.value;
-        for (int i = 0; i < count; i++) {
-          final keyPtr = keysArray.elementAt(i).value;
-          if (keyPtr != nullptr) {
-            calloc.free(keyPtr);
-          }
-        }
-        calloc.free(keysArray);
+      // The array belongs to the library; the keys are interned and not freed
+      if (keysPtr.value != nullptr) {
+        flowCore.native.flow_free_string_array(keysPtr.value, countPtr.value);
       }
       calloc.free(keysPtr);
       calloc.free(countPtr);
@@ -487,17 +477,9 @@ class Node {
 
       return keys;
     } finally {
-      // Clean up allocated memory
-      final count = countPtr.value;
-      if (count > 0 && keysPtr.value != nullptr) {
-        final keysArray = keysPtr.value;
-        for (int i = 0; i < count; i++) {
-          final keyPtr = keysArray.elementAt(i).value;
-          if (keyPtr != nullptr) {
-            calloc.free(keyPtr);
-          }
-        }
-        calloc.free(keysArray);
+      // The array belongs to the library; the keys are interned and not freed
+      if (keysPtr.value != nullptr) {
+        flowCore.native.flow_free_string_array(keysPtr.value, countPtr.value);
       }
       calloc.free(keysPtr);
       calloc.free(countPtr);
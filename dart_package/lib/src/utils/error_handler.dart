@@ -18,6 +18,7 @@ enum FlowError {
   outOfMemory(-8),
   typeMismatch(-9),
   notImplemented(-10),
+  timeout(-11),
   unknown(-999);
 
   const FlowError(this.value);
@@ -104,6 +105,12 @@ class NotImplementedException extends FlowException {
       : super(FlowError.notImplemented, message);
 }
 
+/// Exception for waits that ran out of time
+class FlowTimeoutException extends FlowException {
+  const FlowTimeoutException(String message)
+      : super(FlowError.timeout, message);
+}
+
 /// Exception for unknown errors
 class UnknownFlowException extends FlowException {
   const UnknownFlowException(String message)
@@ -112,13 +119,20 @@ class UnknownFlowException extends FlowException {
 
 /// Utility class for handling errors from the native library
 class ErrorHandler {
-  /// Check for errors after a native function call and throw appropriate exceptions
-  static void checkError() {
+  /// Check for errors after a native function call and throw appropriate exceptions.
+  ///
+  /// [errorCode] is the code the call returned, if it returns one.
+  static void checkError([int? errorCode]) {
     final errorMessage = flowCore.flow_get_last_error();
     if (errorMessage != nullptr) {
       final message = errorMessage.cast<Utf8>().toDartString();
       flowCore.flow_clear_error();
 
+      // A node's own message may mention a timeout, so only the code identifies one
+      if (errorCode == FlowError.timeout.value) {
+        throw FlowTimeoutException(message);
+      }
+
       // Determine error type from message (could be improved with error codes)
       if (message.contains('Invalid handle')) {
         throw InvalidHandleException(message);
@@ -159,7 +173,7 @@ class ErrorHandler {
   /// Check error code and throw exception if not successful
   static void checkErrorCode(int errorCode) {
     if (!isSuccess(errorCode)) {
-      checkError(); // Will throw appropriate exception
+      checkError(errorCode); // Will throw appropriate exception
     }
   }
 
@@ -31,6 +31,7 @@ typedef enum FlowError {
     FLOW_ERROR_OUT_OF_MEMORY = -8,
     FLOW_ERROR_TYPE_MISMATCH = -9,
     FLOW_ERROR_NOT_IMPLEMENTED = -10,
+    FLOW_ERROR_TIMEOUT = -11,
     FLOW_ERROR_UNKNOWN = -999
 } FlowError;
 
@@ -42,6 +43,8 @@ typedef struct FlowEnv* FlowEnvHandle;
 typedef struct FlowNodeFactory* FlowNodeFactoryHandle;
 typedef struct FlowModule* FlowModuleHandle;
 typedef struct FlowNodeData* FlowNodeDataHandle;
+typedef struct FlowContext* FlowContextHandle;
+typedef struct FlowGraphPool* FlowGraphPoolHandle;
 
 // Result structure for operations that may fail
 typedef struct FlowResult {
@@ -77,6 +80,23 @@ FLOW_FFI_EXPORT void flow_clear_error(void);
 // Set custom error message
 FLOW_FFI_EXPORT void flow_set_error(FlowError code, const char* message);
 
+// ============================================================================
+// API Call Statistics
+// ============================================================================
+
+// Per-function call counts, error counts and latency histograms, recorded per thread
+// for every call that goes through the standard error-handling wrapper. Off by default.
+FLOW_FFI_EXPORT void flow_api_stats_enable(bool enabled);
+FLOW_FFI_EXPORT bool flow_api_stats_is_enabled(void);
+
+// Discard everything recorded so far
+FLOW_FFI_EXPORT void flow_api_stats_reset(void);
+
+// JSON report: {"enabled", "functions": [{"name", "calls", "errors", "total_ns", "mean_ns",
+// "p50_ns", "p99_ns", "max_ns", "histogram": [{"lt_ns", "count"}]}]}, sorted by total
+// time. Histogram buckets are powers of two. Free with flow_free_string.
+FLOW_FFI_EXPORT char* flow_get_api_stats(void);
+
 // ============================================================================
 // Handle Management
 // ============================================================================
@@ -148,6 +168,22 @@ FLOW_FFI_EXPORT FlowError flow_graph_get_connections(FlowGraphHandle graph,
                                                      FlowConnectionInfo** connections,
                                                      size_t* count);
 
+// Topology snapshots. Node, connection and neighbor queries read an immutable snapshot
+// of the topology, so they stay consistent while other threads add, remove or connect
+// nodes, and take no lock unless the graph changed since the last query.
+typedef enum FlowNeighborDirection {
+    FLOW_NEIGHBORS_UPSTREAM = 0,  // Nodes feeding the node's inputs
+    FLOW_NEIGHBORS_DOWNSTREAM = 1 // Nodes fed by the node's outputs
+} FlowNeighborDirection;
+
+// Ids of the direct neighbors of a node. Free with flow_free_string_array.
+FLOW_FFI_EXPORT FlowError flow_graph_get_neighbors(FlowGraphHandle graph, const char* node_id,
+                                                   FlowNeighborDirection direction,
+                                                   char*** node_ids, size_t* count);
+
+// Incremented by every topology change made through the graph handle
+FLOW_FFI_EXPORT uint64_t flow_graph_get_topology_version(FlowGraphHandle graph);
+
 // Check if two nodes can be connected
 FLOW_FFI_EXPORT bool flow_graph_can_connect(FlowGraphHandle graph, const char* source_id,
                                             const char* source_port, const char* target_id,
@@ -159,7 +195,8 @@ FLOW_FFI_EXPORT FlowError flow_graph_run(FlowGraphHandle graph);
 // Clear all nodes and connections
 FLOW_FFI_EXPORT FlowError flow_graph_clear(FlowGraphHandle graph);
 
-// Serialization
+// Serialization. Loading first loads the deferred modules behind the saved classes;
+// FLOW_ERROR_NODE_NOT_FOUND, with the graph unchanged, if a class is still unknown.
 FLOW_FFI_EXPORT char* flow_graph_save_to_json(FlowGraphHandle graph);
 FLOW_FFI_EXPORT FlowError flow_graph_load_from_json(FlowGraphHandle graph, const char* json);
 
@@ -171,7 +208,9 @@ FLOW_FFI_EXPORT FlowError flow_node_load_from_json(FlowNodeHandle node, const ch
 // Node Management
 // ============================================================================
 
-// Get node properties
+// Get node properties. The id is owned by the node handle (valid until it is released)
+// and the class name is interned; neither needs flow_free_string. The name can change,
+// so it is returned as a copy that must be freed with flow_free_string.
 FLOW_FFI_EXPORT const char* flow_node_get_id(FlowNodeHandle node);
 FLOW_FFI_EXPORT const char* flow_node_get_name(FlowNodeHandle node);
 FLOW_FFI_EXPORT const char* flow_node_get_class(FlowNodeHandle node);
@@ -201,14 +240,15 @@ FLOW_FFI_EXPORT bool flow_node_validate_required_inputs(FlowNodeHandle node);
 FLOW_FFI_EXPORT bool flow_node_has_connected_inputs(FlowNodeHandle node);
 FLOW_FFI_EXPORT bool flow_node_has_connected_outputs(FlowNodeHandle node);
 
-// Port introspection
+// Port introspection. The array must be freed with flow_free_string_array; the keys
+// are interned and stay valid for the lifetime of the process.
 FLOW_FFI_EXPORT FlowError flow_node_get_input_port_keys(FlowNodeHandle node, char*** port_keys,
                                                         size_t* count);
 
 FLOW_FFI_EXPORT FlowError flow_node_get_output_port_keys(FlowNodeHandle node, char*** port_keys,
                                                          size_t* count);
 
-// Get port type information
+// Get port type information (interned, do not free)
 FLOW_FFI_EXPORT const char* flow_node_get_input_port_type(FlowNodeHandle node,
                                                           const char* port_key);
 
@@ -257,7 +297,8 @@ FLOW_FFI_EXPORT void flow_free_port_metadata(FlowPortMetadata* metadata);
 // Connection Management
 // ============================================================================
 
-// Get connection properties
+// Get connection properties. Ids are owned by the connection handle, port keys are
+// interned; none of them need to be freed.
 FLOW_FFI_EXPORT const char* flow_connection_get_id(FlowConnectionHandle conn);
 FLOW_FFI_EXPORT const char* flow_connection_get_start_node_id(FlowConnectionHandle conn);
 FLOW_FFI_EXPORT const char* flow_connection_get_start_port(FlowConnectionHandle conn);
@@ -315,12 +356,111 @@ FLOW_FFI_EXPORT FlowError flow_module_unregister_nodes(FlowModuleHandle module);
 // Check if module is loaded
 FLOW_FFI_EXPORT bool flow_module_is_loaded(FlowModuleHandle module);
 
-// Get module metadata
+// Lazy loading: when enabled before flow_module_load, only the path and manifest are
+// recorded. The shared library is loaded and its nodes registered the first time one of
+// its classes is created (or on flow_module_materialize). A deferred module reports
+// flow_module_is_loaded == true and flow_module_is_resident == false.
+FLOW_FFI_EXPORT FlowError flow_module_set_lazy(FlowModuleHandle module, bool lazy);
+
+// Check if the module's shared library is actually loaded
+FLOW_FFI_EXPORT bool flow_module_is_resident(FlowModuleHandle module);
+
+// Perform a deferred load and registration now (no-op for resident modules)
+FLOW_FFI_EXPORT FlowError flow_module_materialize(FlowModuleHandle module);
+
+// Result of a module hot-reload
+typedef struct FlowModuleReloadStats {
+    size_t graphs_affected;      // Open graphs that contained nodes of the module
+    size_t nodes_migrated;       // Nodes re-created with their saved state
+    size_t nodes_dropped;        // Nodes whose class no longer exists after the reload
+    size_t connections_restored; // Connections re-established to migrated nodes
+    size_t connections_dropped;  // Connections that no longer type-check or whose ports vanished
+    double save_time_ms;         // Saving state and detaching the old nodes
+    double swap_time_ms;         // Unregister, unload, load and register
+    double restore_time_ms;      // Re-creating nodes and connections
+    double total_time_ms;
+} FlowModuleReloadStats;
+
+// Reload a module from its path and migrate live nodes: every node of the module's
+// classes in open graphs and node handles is saved, the shared library is swapped and
+// the nodes are re-created in place with the same id, name, state and connections.
+// Node handles keep working; node event subscriptions must be registered again.
+// Context outputs, pooled workers and cached or folded values of every graph are
+// dropped first, and so are values the old nodes computed from the ports of the nodes
+// they fed. Fails if a context is running, or if an old node or one of its output
+// values is still referenced elsewhere (for example by a data handle from
+// flow_node_get_output_data), leaving the module and its nodes as they were. stats may
+// be NULL.
+FLOW_FFI_EXPORT FlowError flow_module_reload(FlowModuleHandle module,
+                                             FlowModuleReloadStats* stats);
+
+// Load profile of a module. Module::Load (unpacking, metadata parsing, dlopen and
+// static initializers) is a single phase in flow-core; the shared objects it mapped
+// and their dynamic symbols are counted to tell heavy libraries apart.
+typedef struct FlowModuleLoadStats {
+    double manifest_time_ms;        // Reading module.json for a deferred load
+    double load_time_ms;            // Last Module::Load
+    double register_time_ms;        // Last RegisterModuleNodes
+    double reload_time_ms;          // Last flow_module_reload, 0 if never reloaded
+    size_t shared_objects_loaded;   // Objects mapped by the last load (0 in parallel batches)
+    size_t dynamic_symbols;         // Dynamic symbols of those objects
+    size_t node_classes_registered; // Classes currently registered by the module
+    int32_t load_count;             // Successful loads including reloads
+    bool lazy;                      // Module is in lazy mode
+    bool from_index;                // Catalog entries came from the manifest index
+    bool resident;                  // Shared library is currently loaded
+} FlowModuleLoadStats;
+
+// Get the load profile of a module
+FLOW_FFI_EXPORT FlowError flow_module_get_load_stats(FlowModuleHandle module,
+                                                     FlowModuleLoadStats* stats);
+
+// Startup report across all live module handles as JSON (totals plus one entry per
+// module, slowest first). Free with flow_free_string.
+FLOW_FFI_EXPORT char* flow_modules_get_load_report(void);
+
+// Get module metadata. The strings are interned: they stay valid after a reload and
+// need no flow_free_string.
 FLOW_FFI_EXPORT const char* flow_module_get_name(FlowModuleHandle module);
 FLOW_FFI_EXPORT const char* flow_module_get_version(FlowModuleHandle module);
 FLOW_FFI_EXPORT const char* flow_module_get_author(FlowModuleHandle module);
 FLOW_FFI_EXPORT const char* flow_module_get_description(FlowModuleHandle module);
 
+// Options for batch module loading (pass NULL for defaults)
+typedef struct FlowModuleLoadOptions {
+    int32_t max_threads;    // Loader threads, <= 0 uses the hardware concurrency
+    bool register_nodes;    // Register node classes after all modules are loaded
+    bool continue_on_error; // Keep going when a module fails (otherwise roll back)
+    bool lazy;              // Defer loading of every module (see flow_module_set_lazy)
+    const char* index_path; // Manifest index file to read and refresh, NULL disables it
+} FlowModuleLoadOptions;
+
+// Per-module result of a batch load, in deterministic (sorted path) order
+typedef struct FlowModuleLoadResult {
+    const char* path;          // Module path
+    const char* error_message; // NULL on success
+    FlowModuleHandle module;   // Loaded module, NULL on failure (destroy with flow_module_destroy)
+    FlowError error;           // FLOW_SUCCESS or the failure code for this module; also
+                               // FLOW_ERROR_MODULE_LOAD_FAILED if a rollback unloaded it
+    double load_time_ms;       // Time spent loading on the worker thread
+    double register_time_ms;   // Time spent registering node classes
+} FlowModuleLoadResult;
+
+// Discover all *.fmod entries in a directory, load them in parallel and register
+// their nodes in sorted path order under a single factory lock. Returns
+// FLOW_ERROR_MODULE_LOAD_FAILED if any module failed; results are filled either way.
+// With an index_path, modules whose path, mtime and size match the index are not
+// loaded: they are deferred (as with lazy) and their node classes are published from
+// the index. Changed modules are loaded and the index is rewritten.
+FLOW_FFI_EXPORT FlowError flow_modules_load_directory(FlowNodeFactoryHandle factory,
+                                                      const char* directory,
+                                                      const FlowModuleLoadOptions* options,
+                                                      FlowModuleLoadResult** results,
+                                                      size_t* count);
+
+// Free a result array from flow_modules_load_directory (module handles are not released)
+FLOW_FFI_EXPORT void flow_free_module_load_results(FlowModuleLoadResult* results, size_t count);
+
 // ============================================================================
 // Data Type Management
 // ============================================================================
@@ -337,7 +477,7 @@ FLOW_FFI_EXPORT FlowError flow_data_get_double(FlowNodeDataHandle data, double*
 FLOW_FFI_EXPORT FlowError flow_data_get_bool(FlowNodeDataHandle data, bool* value);
 FLOW_FFI_EXPORT FlowError flow_data_get_string(FlowNodeDataHandle data, char** value);
 
-// Get data type
+// Get data type (interned, do not free)
 FLOW_FFI_EXPORT const char* flow_data_get_type(FlowNodeDataHandle data);
 
 // Destroy data
@@ -346,11 +486,16 @@ FLOW_FFI_EXPORT void flow_data_destroy(FlowNodeDataHandle data);
 // Convert data to string representation
 FLOW_FFI_EXPORT const char* flow_data_to_string(FlowNodeDataHandle data);
 
+// Estimated bytes held by the value (object plus owned heap storage), 0 on error.
+// Fails with FLOW_ERROR_NOT_IMPLEMENTED for a type with no sizer (see
+// flow_register_data_sizer).
+FLOW_FFI_EXPORT size_t flow_data_get_memory_size(FlowNodeDataHandle data);
+
 // ============================================================================
 // Memory Management Helpers
 // ============================================================================
 
-// Free strings allocated by the library
+// Free strings allocated by the library (a no-op for interned and handle-owned strings)
 FLOW_FFI_EXPORT void flow_free_string(char* str);
 
 // Free string arrays
@@ -362,6 +507,275 @@ FLOW_FFI_EXPORT void flow_free_handle_array(void** array);
 // Free connection info arrays
 FLOW_FFI_EXPORT void flow_free_connection_array(FlowConnectionInfo* connections, size_t count);
 
+// Allocator hooks. Every heap buffer returned by the library (strings, handle arrays,
+// FlowConnectionInfo, FlowPortMetadata, load results) comes from alloc_fn and can be
+// released either with the matching flow_free_* function or with free_fn directly.
+// Handle wrappers are allocated through the hooks as well. alloc_fn must return memory
+// aligned like malloc, or null on failure. Pass null for both to restore the default
+// (operator new[]/delete[]).
+// The hooks can be switched at any time: flow_free_* releases every buffer with the
+// free function of the allocator it came from. A caller releasing a buffer with free_fn
+// directly must use that allocator's free_fn.
+typedef void* (*FlowAllocFn)(size_t size, void* user_data);
+typedef void (*FlowFreeFn)(void* ptr, void* user_data);
+FLOW_FFI_EXPORT FlowError flow_set_allocator(FlowAllocFn alloc_fn, FlowFreeFn free_fn,
+                                             void* user_data);
+
+// Per-thread result arena. While enabled, strings and arrays returned to the calling
+// thread are bump-allocated from a thread-local arena instead of the heap. They stay
+// valid until flow_result_arena_reset, which releases them all at once; the flow_free_*
+// functions above skip arena memory, so existing cleanup code keeps working.
+FLOW_FFI_EXPORT void flow_result_arena_enable(bool enabled);
+FLOW_FFI_EXPORT bool flow_result_arena_is_enabled(void);
+
+// Invalidate every result handed out from the calling thread's arena
+FLOW_FFI_EXPORT void flow_result_arena_reset(void);
+
+// Bytes currently allocated from the calling thread's arena
+FLOW_FFI_EXPORT size_t flow_result_arena_bytes_used(void);
+
+// ============================================================================
+// Memory Accounting
+// ============================================================================
+
+// Estimated NodeData bytes held by node ports. A value shared by several ports (an
+// output feeding connected inputs) is counted once.
+typedef struct FlowMemoryUsage {
+    size_t total_bytes;   // Distinct NodeData values held
+    size_t data_count;    // Number of distinct NodeData values
+    size_t unknown_count; // Values of types with no sizer, counted in data_count only
+    size_t node_count;
+    size_t graph_count;
+} FlowMemoryUsage;
+
+// Size of the value data points to, a flow::NodeData of the registered type
+typedef size_t (*FlowDataSizerFn)(const void* data);
+
+// Measures values whose type name is type_name, such as types a module defines. Values of
+// types with no sizer are reported as unknown rather than guessed. A null sizer removes
+// the registration; a module must remove its sizers before it is unloaded. Built-in
+// types cannot be overridden.
+FLOW_FFI_EXPORT FlowError flow_register_data_sizer(const char* type_name,
+                                                   FlowDataSizerFn sizer);
+
+FLOW_FFI_EXPORT FlowError flow_graph_get_memory_usage(FlowGraphHandle graph,
+                                                      FlowMemoryUsage* usage);
+
+// Graph breakdown as JSON with the top_n nodes by input + output bytes, each with the
+// number of values it holds that have no size estimate ("unknown_count"). Free with
+// flow_free_string.
+FLOW_FFI_EXPORT char* flow_graph_get_memory_report(FlowGraphHandle graph, size_t top_n);
+
+// Totals across all open graphs created with the environment
+FLOW_FFI_EXPORT FlowError flow_env_get_memory_usage(FlowEnvHandle env, FlowMemoryUsage* usage);
+
+// The top_n open graphs by bytes, each with its top_n nodes, as JSON. Each graph is
+// measured on its own (what releasing it would free), and "handle" matches its
+// FlowGraphHandle formatted with %p. Free with flow_free_string.
+FLOW_FFI_EXPORT char* flow_get_memory_report(size_t top_n);
+
+// ============================================================================
+// Execution Contexts
+// ============================================================================
+
+// A context runs a graph with its own port values. The graph's topology and node
+// configuration are shared read-only by all its contexts, and the graph's nodes are never
+// written to, so several contexts of one graph may run at the same time on different
+// threads. A single context must not be used from two threads at once.
+//
+// A run computes every node in topological order. A node input takes, in order: the value
+// set on the context, the output of its upstream node in this run if it is connected, or
+// the value held by the graph's node. A node missing an input is skipped, like flow-core.
+// Graph edits are picked up on the next run.
+FLOW_FFI_EXPORT FlowContextHandle flow_graph_create_context(FlowGraphHandle graph);
+
+// Fails with FLOW_ERROR_INVALID_ARGUMENT for a context acquired from a pool
+FLOW_FFI_EXPORT void flow_context_destroy(FlowContextHandle context);
+
+// Pass null data to remove a value set earlier
+FLOW_FFI_EXPORT FlowError flow_context_set_input(FlowContextHandle context, const char* node_id,
+                                                 const char* port_key, FlowNodeDataHandle data);
+
+// FLOW_ERROR_COMPUTATION_FAILED if the graph has a cycle or a node fails, and
+// FLOW_ERROR_TIMEOUT if a time budget ran out (see flow_context_set_timeouts); the outputs
+// computed before the failure stay readable
+FLOW_FFI_EXPORT FlowError flow_context_run(FlowContextHandle context);
+
+// Output of the last run, or null if the node did not produce one. Release with
+// flow_data_destroy.
+FLOW_FFI_EXPORT FlowNodeDataHandle flow_context_get_output(FlowContextHandle context,
+                                                           const char* node_id,
+                                                           const char* port_key);
+
+// Drop every input set and every output of the last run
+FLOW_FFI_EXPORT FlowError flow_context_clear(FlowContextHandle context);
+
+// Marks an output port as observed, or no longer observed. With dead-node elimination on,
+// a run computes only the nodes feeding an observed port: the sinks marked here and the
+// output bindings of flow_graph_set_bindings. Node event registrations do not count;
+// context runs compute on copies of the nodes and never fire them. Node granular: every
+// output of a node feeding an observed port is computed.
+FLOW_FFI_EXPORT FlowError flow_graph_set_sink(FlowGraphHandle graph, const char* node_id,
+                                              const char* port_key, bool is_sink);
+
+// Off by default. With nothing observed, a run computes nothing.
+FLOW_FFI_EXPORT FlowError flow_context_set_dead_node_elimination(FlowContextHandle context,
+                                                                 bool enabled);
+
+// Off by default. A node is constant when it has inputs and each one is either left
+// unconnected or fed by a constant node; its inputs then only change through
+// flow_node_set_input_data. A constant node is computed once and its outputs are frozen
+// until one of its input values changes. Nodes the context sets inputs on are not folded
+// in that context. Only turn this on when no node has side effects or hidden state.
+FLOW_FFI_EXPORT FlowError flow_context_set_constant_folding(FlowContextHandle context,
+                                                            bool enabled);
+
+// Lets a run spread independent nodes over up to max_threads threads, the calling one
+// included; 0 uses one per core. The default of 1 runs every node on the calling thread.
+FLOW_FFI_EXPORT FlowError flow_context_set_parallelism(FlowContextHandle context,
+                                                       size_t max_threads);
+
+// Time budgets for the context's runs, in milliseconds, 0 for none. A node computing for
+// longer than node_timeout_ms, or a run lasting longer than run_timeout_ms, fails the run
+// with FLOW_ERROR_TIMEOUT: nodes not started yet are cancelled, the node that ran over gets
+// an OnError event, and the outputs of nodes that finished stay readable. A node that is
+// stuck cannot be interrupted; its result is discarded when it returns. With a budget set,
+// nodes compute on helper threads while the calling thread watches. flow_graph_run runs
+// inside the graph itself and is not covered.
+FLOW_FFI_EXPORT FlowError flow_context_set_timeouts(FlowContextHandle context,
+                                                    uint64_t node_timeout_ms,
+                                                    uint64_t run_timeout_ms);
+
+// Which ready task a parallel run starts first when there are more than free threads
+typedef enum FlowSchedulingPolicy {
+    FLOW_SCHEDULE_FIFO = 0,         // In the order they became ready
+    FLOW_SCHEDULE_CRITICAL_PATH = 1 // Longest remaining path of measured compute time first
+} FlowSchedulingPolicy;
+
+// Defaults to FLOW_SCHEDULE_CRITICAL_PATH. Until its nodes are measured a path is as long
+// as its node count.
+FLOW_FFI_EXPORT FlowError flow_context_set_scheduling_policy(FlowContextHandle context,
+                                                             FlowSchedulingPolicy policy);
+
+// Parallel runs schedule a chain of nodes, each the only consumer of the previous one,
+// as one task computed back to back on one thread while the chain's measured compute
+// time stays within max_task_cost_ns (default 50000). Nodes not yet measured count as
+// free. 0 disables fusion, scheduling every node separately.
+FLOW_FFI_EXPORT FlowError flow_graph_set_fusion_threshold(FlowGraphHandle graph,
+                                                          uint64_t max_task_cost_ns);
+
+// Persistent cache of node outputs in directory, shared by every graph and process using
+// it. Before a node computes, its outputs are looked up by a hash of its class, its saved
+// state without id and name, and its input values; after it computed they are stored.
+// Only nodes whose inputs and outputs are all int, double, bool or string values take
+// part, and they must be deterministic. Nodes measured faster than min_compute_ns are
+// neither looked up nor stored. When the entries exceed max_bytes (0 for no limit), the
+// least recently used ones of every process are deleted. Pass a null directory to stop
+// using the cache. Applies to contexts, pools, invoke and evaluate, not flow_graph_run.
+FLOW_FFI_EXPORT FlowError flow_graph_set_output_cache(FlowGraphHandle graph,
+                                                      const char* directory,
+                                                      uint64_t max_bytes,
+                                                      uint64_t min_compute_ns);
+
+typedef struct FlowRunStats {
+    size_t nodes_computed;
+    size_t nodes_skipped_dead; // Feed no observed port
+    size_t nodes_not_ready;    // An input had no value
+    size_t nodes_folded;       // Constant, outputs reused without computing
+    size_t nodes_cached;       // Outputs loaded from the output cache
+    size_t tasks_scheduled;    // Scheduling units of a parallel run, 0 when sequential
+    uint64_t duration_ns;
+} FlowRunStats;
+
+// Counters of the context's last run
+FLOW_FFI_EXPORT FlowError flow_context_get_run_stats(FlowContextHandle context,
+                                                     FlowRunStats* stats);
+
+// Pool of size contexts of one graph for request-serving workloads. Contexts and the
+// node copies they compute with are created up front, so the latency of a request
+// excludes graph construction and the memory held is bounded by size. The copies outlive
+// topology changes; only nodes added later get theirs on first use.
+FLOW_FFI_EXPORT FlowGraphPoolHandle flow_graph_pool_create(FlowGraphHandle graph, size_t size);
+
+// Contexts still checked out become invalid handles
+FLOW_FFI_EXPORT void flow_graph_pool_destroy(FlowGraphPoolHandle pool);
+
+// A free context, waiting up to timeout_ms for one (negative waits indefinitely). Null
+// with FLOW_ERROR_TIMEOUT if none became free. Do not destroy the context; release it.
+FLOW_FFI_EXPORT FlowContextHandle flow_graph_pool_acquire(FlowGraphPoolHandle pool,
+                                                          int64_t timeout_ms);
+
+// Clears the context's inputs and outputs and returns it to the pool
+FLOW_FFI_EXPORT FlowError flow_graph_pool_release(FlowGraphPoolHandle pool,
+                                                  FlowContextHandle context);
+
+// Number of contexts currently free
+FLOW_FFI_EXPORT size_t flow_graph_pool_available(FlowGraphPoolHandle pool);
+
+// ============================================================================
+// Function-style Invocation
+// ============================================================================
+
+// A node port used as a graph-level input or output
+typedef struct FlowPortRef {
+    const char* node_id;
+    const char* port_key;
+} FlowPortRef;
+
+typedef enum FlowValueType {
+    FLOW_VALUE_NONE = 0, // Input: leave the port alone. Output: nothing was produced.
+    FLOW_VALUE_INT = 1,
+    FLOW_VALUE_DOUBLE = 2,
+    FLOW_VALUE_BOOL = 3,
+    FLOW_VALUE_STRING = 4 // Byte buffer, may contain NULs
+} FlowValueType;
+
+typedef struct FlowBuffer {
+    const char* data;
+    size_t size;
+} FlowBuffer;
+
+// A value packed for a single FFI crossing
+typedef struct FlowValue {
+    FlowValueType type;
+    union {
+        int32_t int_value;
+        double double_value;
+        bool bool_value;
+        FlowBuffer string_value;
+    } as;
+} FlowValue;
+
+// Declares the graph's inputs and outputs once, in the order flow_graph_invoke takes
+// them. Input refs must be node input ports and output refs node output ports.
+FLOW_FFI_EXPORT FlowError flow_graph_set_bindings(FlowGraphHandle graph,
+                                                  const FlowPortRef* inputs, size_t input_count,
+                                                  const FlowPortRef* outputs,
+                                                  size_t output_count);
+
+// Runs the graph as a function, like a fresh execution context: inputs holds one value per
+// input binding and outputs receives one value per output binding. String outputs are
+// owned by the caller; release them with flow_free_values. Safe to call concurrently.
+FLOW_FFI_EXPORT FlowError flow_graph_invoke(FlowGraphHandle graph, const FlowValue* inputs,
+                                            FlowValue* outputs);
+
+// Frees the string buffers of values filled by the library and resets them to NONE
+FLOW_FFI_EXPORT void flow_free_values(FlowValue* values, size_t count);
+
+// ============================================================================
+// Lazy Evaluation
+// ============================================================================
+
+// Computes one output by running only the nodes it depends on, without touching the
+// graph's nodes. Outputs from earlier evaluations are reused for every node whose input
+// values are the same ones as last time. Returns null if the node cannot run because an
+// input has no value; release the result with flow_data_destroy.
+FLOW_FFI_EXPORT FlowNodeDataHandle flow_graph_evaluate(FlowGraphHandle graph, const char* node_id,
+                                                       const char* port_key);
+
+// Drop the outputs kept for flow_graph_evaluate
+FLOW_FFI_EXPORT FlowError flow_graph_clear_evaluation_cache(FlowGraphHandle graph);
+
 // ============================================================================
 // Event Callbacks (Phase 5)
 // ============================================================================
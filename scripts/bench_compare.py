@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON result files and flag regressions.
+
+Usage: bench_compare.py BASELINE CURRENT [--threshold PERCENT] [--metric real_time|cpu_time]
+
+Exits with 1 if any benchmark present in both files got slower by more than the
+threshold, 0 otherwise. Benchmarks only present on one side are listed but never fail.
+"""
+
+import argparse
+import json
+import sys
+
+UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    with open(path) as f:
+        data = json.load(f)
+
+    results = {}
+    for bench in data.get("benchmarks", []):
+        # With repetitions, compare the median aggregate only
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "median":
+            continue
+        if bench.get("error_occurred"):
+            continue
+        name = bench.get("run_name", bench["name"])
+        results[name] = bench[metric] * UNIT_TO_NS[bench.get("time_unit", "ns")]
+    return results
+
+
+def format_ns(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return f"{ns / scale:.2f} {unit}"
+    return f"{ns:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+
+    regressions = []
+    width = max((len(name) for name in baseline.keys() | current.keys()), default=9)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>12}  {'Current':>12}  {'Change':>8}")
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in baseline or name not in current:
+            side = "baseline" if name in baseline else "current"
+            print(f"{name:<{width}}  (only in {side})")
+            continue
+
+        before, after = baseline[name], current[name]
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        flag = "  REGRESSION" if change > args.threshold else ""
+        print(f"{name:<{width}}  {format_ns(before):>12}  {format_ns(after):>12}  "
+              f"{change:+7.1f}%{flag}")
+        if flag:
+            regressions.append(name)
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold}%")
+        return 1
+    print(f"\nNo regressions above {args.threshold}%")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -18,7 +18,7 @@ EXIT_CODE=0
 echo "1. Checking C++ formatting..."
 cd "$PROJECT_ROOT"
 
-CPP_FILES=$(find src include test -type f \( -name "*.cpp" -o -name "*.h" -o -name "*.hpp" \) \
+CPP_FILES=$(find src include test bench -type f \( -name "*.cpp" -o -name "*.h" -o -name "*.hpp" \) \
   ! -path "*/build/*" \
   ! -path "*/.dart_tool/*" \
   ! -path "*/CMakeFiles/*" 2>/dev/null || true)
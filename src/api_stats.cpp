@@ -0,0 +1,189 @@
+#include "api_stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "flow_ffi.h"
+#include "result_memory.hpp"
+#include <nlohmann/json.hpp>
+
+namespace flow_ffi {
+
+namespace {
+
+// Bucket i counts calls that took less than 2^i ns; the last bucket takes the rest
+constexpr std::size_t kLatencyBuckets = 40;
+
+struct FunctionStats {
+    std::uint64_t calls = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t total_ns = 0;
+    std::uint64_t max_ns = 0;
+    std::array<std::uint64_t, kLatencyBuckets> buckets{};
+
+    void merge(const FunctionStats& other) {
+        calls += other.calls;
+        errors += other.errors;
+        total_ns += other.total_ns;
+        max_ns = std::max(max_ns, other.max_ns);
+        for (std::size_t i = 0; i < kLatencyBuckets; ++i) {
+            buckets[i] += other.buckets[i];
+        }
+    }
+
+    // Upper bound of the bucket holding the given fraction of calls
+    std::uint64_t percentile_ns(double fraction) const {
+        auto target = static_cast<std::uint64_t>(fraction * static_cast<double>(calls));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kLatencyBuckets; ++i) {
+            seen += buckets[i];
+            if (seen > target) {
+                return std::min(std::uint64_t{1} << i, max_ns);
+            }
+        }
+        return max_ns;
+    }
+};
+
+// Keyed by the __func__ pointer; owner thread writes, aggregation reads under mutex
+struct ThreadStats {
+    std::mutex mutex;
+    std::unordered_map<const char*, FunctionStats> functions;
+};
+
+struct StatsRegistry {
+    std::mutex mutex;
+    std::vector<ThreadStats*> live;
+    std::map<std::string, FunctionStats> retired; // From threads that have exited
+};
+
+// Never destroyed: the main thread's slot is torn down after static destructors run
+StatsRegistry& registry() {
+    static auto* instance = new StatsRegistry();
+    return *instance;
+}
+
+class ThreadStatsSlot {
+public:
+    ThreadStatsSlot() {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        registry().live.push_back(&stats_);
+    }
+
+    ~ThreadStatsSlot() {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& [name, function] : stats_.functions) {
+            reg.retired[name].merge(function);
+        }
+        reg.live.erase(std::find(reg.live.begin(), reg.live.end(), &stats_));
+    }
+
+    ThreadStats& stats() { return stats_; }
+
+private:
+    ThreadStats stats_;
+};
+
+ThreadStats& thread_stats() {
+    thread_local ThreadStatsSlot slot;
+    return slot.stats();
+}
+
+} // namespace
+
+void record_api_call(const char* function, std::chrono::nanoseconds elapsed, bool failed) {
+    auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed.count(), 0));
+    std::size_t bucket = std::min<std::size_t>(std::bit_width(ns), kLatencyBuckets - 1);
+
+    auto& stats = thread_stats();
+    std::lock_guard<std::mutex> lock(stats.mutex);
+    auto& entry = stats.functions[function];
+    ++entry.calls;
+    entry.errors += failed ? 1 : 0;
+    entry.total_ns += ns;
+    entry.max_ns = std::max(entry.max_ns, ns);
+    ++entry.buckets[bucket];
+}
+
+void reset_api_stats() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.retired.clear();
+    for (auto* stats : reg.live) {
+        std::lock_guard<std::mutex> thread_lock(stats->mutex);
+        stats->functions.clear();
+    }
+}
+
+std::string api_stats_json() {
+    std::map<std::string, FunctionStats> merged;
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        merged = reg.retired;
+        for (auto* stats : reg.live) {
+            std::lock_guard<std::mutex> thread_lock(stats->mutex);
+            for (const auto& [name, function] : stats->functions) {
+                merged[name].merge(function);
+            }
+        }
+    }
+
+    std::vector<std::pair<std::string, FunctionStats>> ordered(merged.begin(), merged.end());
+    std::stable_sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        return a.second.total_ns > b.second.total_ns;
+    });
+
+    nlohmann::json functions = nlohmann::json::array();
+    for (const auto& [name, stats] : ordered) {
+        nlohmann::json histogram = nlohmann::json::array();
+        for (std::size_t i = 0; i < kLatencyBuckets; ++i) {
+            if (stats.buckets[i] > 0) {
+                histogram.push_back(
+                    {{"lt_ns", std::uint64_t{1} << i}, {"count", stats.buckets[i]}});
+            }
+        }
+
+        functions.push_back({{"name", name},
+                             {"calls", stats.calls},
+                             {"errors", stats.errors},
+                             {"total_ns", stats.total_ns},
+                             {"mean_ns", stats.calls ? stats.total_ns / stats.calls : 0},
+                             {"p50_ns", stats.percentile_ns(0.50)},
+                             {"p99_ns", stats.percentile_ns(0.99)},
+                             {"max_ns", stats.max_ns},
+                             {"histogram", std::move(histogram)}});
+    }
+
+    nlohmann::json report = {{"enabled", api_stats_enabled()}, {"functions", std::move(functions)}};
+    return report.dump(2);
+}
+
+} // namespace flow_ffi
+
+extern "C" {
+
+FLOW_FFI_EXPORT void flow_api_stats_enable(bool enabled) {
+    flow_ffi::api_stats_flag().store(enabled, std::memory_order_relaxed);
+}
+
+FLOW_FFI_EXPORT bool flow_api_stats_is_enabled(void) {
+    return flow_ffi::api_stats_enabled();
+}
+
+FLOW_FFI_EXPORT void flow_api_stats_reset(void) {
+    flow_ffi::reset_api_stats();
+}
+
+FLOW_FFI_EXPORT char* flow_get_api_stats(void) {
+    FLOW_API_CALL_HANDLE({ return flow_ffi::copy_string(flow_ffi::api_stats_json()); });
+}
+
+} // extern "C"
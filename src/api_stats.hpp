@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace flow_ffi {
+
+// Per-function call statistics recorded by the FLOW_API_CALL* macros. Recording is off
+// by default; while disabled a call costs one relaxed atomic load. While enabled each
+// call records its count, whether it set an error and a log2-bucketed latency, into
+// storage owned by the calling thread. flow_get_api_stats merges all threads.
+
+inline std::atomic<bool>& api_stats_flag() {
+    static std::atomic<bool> enabled{false};
+    return enabled;
+}
+
+inline bool api_stats_enabled() {
+    return api_stats_flag().load(std::memory_order_relaxed);
+}
+
+// Bumped by ErrorManager::set_error so a recorder can tell whether its call failed
+inline std::uint64_t& thread_error_sequence() {
+    thread_local std::uint64_t sequence = 0;
+    return sequence;
+}
+
+void record_api_call(const char* function, std::chrono::nanoseconds elapsed, bool failed);
+void reset_api_stats();
+std::string api_stats_json();
+
+class ApiCallRecorder {
+public:
+    explicit ApiCallRecorder(const char* function)
+        : function_(api_stats_enabled() ? function : nullptr) {
+        if (function_) {
+            errors_before_ = thread_error_sequence();
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ApiCallRecorder() {
+        if (function_) {
+            record_api_call(function_, std::chrono::steady_clock::now() - start_,
+                            thread_error_sequence() != errors_before_);
+        }
+    }
+
+    ApiCallRecorder(const ApiCallRecorder&) = delete;
+    ApiCallRecorder& operator=(const ApiCallRecorder&) = delete;
+
+private:
+    const char* function_;
+    std::uint64_t errors_before_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace flow_ffi
@@ -3,8 +3,10 @@
 
 #include "flow_ffi.h"
 
+#include "connection_wrapper.hpp"
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "string_interner.hpp"
 
 // Include flow-core headers
 #include <flow/core/Connection.hpp>
@@ -27,19 +29,16 @@ FLOW_FFI_EXPORT const char* flow_connection_get_id(FlowConnectionHandle conn) {
             return nullptr;
         }
 
-        auto* conn_ptr = flow_ffi::get_handle<SharedConnection>(conn);
-        if (!conn_ptr || !*conn_ptr) {
+        auto* conn_ptr = flow_ffi::get_handle<ConnectionWrapper>(conn);
+        if (!conn_ptr || !conn_ptr->connection) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get connection from handle");
             return nullptr;
         }
 
-        // Convert UUID to string and return as static string
-        static thread_local std::string id_str;
-        id_str = static_cast<std::string>((*conn_ptr)->ID());
-
+        // Formatted once when the handle was created, owned by the handle
         flow_ffi::ErrorManager::instance().clear_error();
-        return id_str.c_str();
+        return conn_ptr->id.c_str();
     });
 }
 
@@ -49,19 +48,15 @@ FLOW_FFI_EXPORT const char* flow_connection_get_start_node_id(FlowConnectionHand
             return nullptr;
         }
 
-        auto* conn_ptr = flow_ffi::get_handle<SharedConnection>(conn);
-        if (!conn_ptr || !*conn_ptr) {
+        auto* conn_ptr = flow_ffi::get_handle<ConnectionWrapper>(conn);
+        if (!conn_ptr || !conn_ptr->connection) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get connection from handle");
             return nullptr;
         }
 
-        // Convert UUID to string and return as static string
-        static thread_local std::string start_id_str;
-        start_id_str = static_cast<std::string>((*conn_ptr)->StartNodeID());
-
         flow_ffi::ErrorManager::instance().clear_error();
-        return start_id_str.c_str();
+        return conn_ptr->start_node_id.c_str();
     });
 }
 
@@ -71,19 +66,16 @@ FLOW_FFI_EXPORT const char* flow_connection_get_start_port(FlowConnectionHandle
             return nullptr;
         }
 
-        auto* conn_ptr = flow_ffi::get_handle<SharedConnection>(conn);
-        if (!conn_ptr || !*conn_ptr) {
+        auto* conn_ptr = flow_ffi::get_handle<ConnectionWrapper>(conn);
+        if (!conn_ptr || !conn_ptr->connection) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get connection from handle");
             return nullptr;
         }
 
-        // Convert IndexableName to string and return as static string
-        static thread_local std::string start_port_str;
-        start_port_str = std::string((*conn_ptr)->StartPortKey().name());
-
+        // Port keys are interned, valid for the lifetime of the process
         flow_ffi::ErrorManager::instance().clear_error();
-        return start_port_str.c_str();
+        return flow_ffi::intern(conn_ptr->connection->StartPortKey().name());
     });
 }
 
@@ -93,19 +85,15 @@ FLOW_FFI_EXPORT const char* flow_connection_get_end_node_id(FlowConnectionHandle
             return nullptr;
         }
 
-        auto* conn_ptr = flow_ffi::get_handle<SharedConnection>(conn);
-        if (!conn_ptr || !*conn_ptr) {
+        auto* conn_ptr = flow_ffi::get_handle<ConnectionWrapper>(conn);
+        if (!conn_ptr || !conn_ptr->connection) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get connection from handle");
             return nullptr;
         }
 
-        // Convert UUID to string and return as static string
-        static thread_local std::string end_id_str;
-        end_id_str = static_cast<std::string>((*conn_ptr)->EndNodeID());
-
         flow_ffi::ErrorManager::instance().clear_error();
-        return end_id_str.c_str();
+        return conn_ptr->end_node_id.c_str();
     });
 }
 
@@ -115,19 +103,15 @@ FLOW_FFI_EXPORT const char* flow_connection_get_end_port(FlowConnectionHandle co
             return nullptr;
         }
 
-        auto* conn_ptr = flow_ffi::get_handle<SharedConnection>(conn);
-        if (!conn_ptr || !*conn_ptr) {
+        auto* conn_ptr = flow_ffi::get_handle<ConnectionWrapper>(conn);
+        if (!conn_ptr || !conn_ptr->connection) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get connection from handle");
             return nullptr;
         }
 
-        // Convert IndexableName to string and return as static string
-        static thread_local std::string end_port_str;
-        end_port_str = std::string((*conn_ptr)->EndPortKey().name());
-
         flow_ffi::ErrorManager::instance().clear_error();
-        return end_port_str.c_str();
+        return flow_ffi::intern(conn_ptr->connection->EndPortKey().name());
     });
 }
 
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <flow/core/Connection.hpp>
+
+#include <memory>
+#include <string>
+
+#include "string_interner.hpp"
+
+// Wrapper structure for Connection handles. Connections are immutable, so the ids are
+// formatted once and lent out by the getters for the lifetime of the handle.
+
+struct ConnectionWrapper {
+    flow::SharedConnection connection;
+    flow_ffi::BorrowedString id;
+    flow_ffi::BorrowedString start_node_id;
+    flow_ffi::BorrowedString end_node_id;
+
+    ConnectionWrapper(flow::SharedConnection c)
+        : connection(std::move(c)),
+          id(connection ? std::string(connection->ID()) : std::string()),
+          start_node_id(connection ? std::string(connection->StartNodeID()) : std::string()),
+          end_node_id(connection ? std::string(connection->EndNodeID()) : std::string()) {}
+};
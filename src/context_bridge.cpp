@@ -0,0 +1,793 @@
+// Execution context bridge
+// Concurrent runs of one graph, each with its own port values
+
+#include "flow_ffi.h"
+
+#include <flow/core/IndexableName.hpp>
+#include <flow/core/NodeData.hpp>
+
+#include "error_handling.hpp"
+#include "graph_executor.hpp"
+#include "handle_manager.hpp"
+#include "node_data_wrapper.hpp"
+#include "result_memory.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace flow;
+
+namespace {
+
+std::shared_ptr<flow_ffi::ExecutionContext> get_context(FlowContextHandle context) {
+    auto* context_ptr = flow_ffi::get_handle<std::shared_ptr<flow_ffi::ExecutionContext>>(context);
+    if (!context_ptr || !*context_ptr) {
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                     "Failed to get context from handle");
+        return nullptr;
+    }
+    return *context_ptr;
+}
+
+std::shared_ptr<flow_ffi::ContextPool> get_pool(FlowGraphPoolHandle pool) {
+    auto* pool_ptr = flow_ffi::get_handle<std::shared_ptr<flow_ffi::ContextPool>>(pool);
+    if (!pool_ptr || !*pool_ptr) {
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                     "Failed to get pool from handle");
+        return nullptr;
+    }
+    return *pool_ptr;
+}
+
+bool get_node_id(const char* node_id, std::string& canonical) {
+    if (!flow_ffi::canonical_node_id(node_id, canonical)) {
+        flow_ffi::ErrorManager::instance().set_error(
+            FLOW_ERROR_INVALID_ARGUMENT, std::string("Invalid UUID format: ") + node_id);
+        return false;
+    }
+    return true;
+}
+
+// Checks ref against the current plan and stores it in canonical form
+FlowError resolve_binding(const flow_ffi::ExecutionPlan& plan, const FlowPortRef& ref,
+                          bool input, flow_ffi::PortBinding& binding) {
+    if (!flow_ffi::validate_string(ref.node_id, "node_id") ||
+        !flow_ffi::validate_string(ref.port_key, "port_key")) {
+        return FLOW_ERROR_INVALID_ARGUMENT;
+    }
+    if (!get_node_id(ref.node_id, binding.node_id)) {
+        return FLOW_ERROR_INVALID_ARGUMENT;
+    }
+
+    auto it = plan.snapshot->node_index.find(binding.node_id);
+    if (it == plan.snapshot->node_index.end()) {
+        flow_ffi::ErrorManager::instance().set_error(
+            FLOW_ERROR_NODE_NOT_FOUND, "Node not found with ID: " + binding.node_id);
+        return FLOW_ERROR_NODE_NOT_FOUND;
+    }
+
+    const auto& node = plan.snapshot->nodes[it->second];
+    const auto& ports = input ? node->GetInputPorts() : node->GetOutputPorts();
+    if (ports.find(IndexableName(ref.port_key)) == ports.end()) {
+        flow_ffi::ErrorManager::instance().set_error(
+            FLOW_ERROR_PORT_NOT_FOUND,
+            std::string(input ? "Input" : "Output") + " port not found: " + ref.port_key);
+        return FLOW_ERROR_PORT_NOT_FOUND;
+    }
+
+    binding.port_key = ref.port_key;
+    return FLOW_SUCCESS;
+}
+
+FlowError make_bindings(const flow_ffi::ExecutionPlan& plan, const FlowPortRef* inputs,
+                        size_t input_count, const FlowPortRef* outputs, size_t output_count,
+                        flow_ffi::GraphBindings& bindings) {
+    bindings.inputs.resize(input_count);
+    for (size_t i = 0; i < input_count; ++i) {
+        FlowError result = resolve_binding(plan, inputs[i], true, bindings.inputs[i]);
+        if (result != FLOW_SUCCESS) {
+            return result;
+        }
+    }
+
+    bindings.outputs.resize(output_count);
+    for (size_t i = 0; i < output_count; ++i) {
+        FlowError result = resolve_binding(plan, outputs[i], false, bindings.outputs[i]);
+        if (result != FLOW_SUCCESS) {
+            return result;
+        }
+    }
+    return FLOW_SUCCESS;
+}
+
+// Null for FLOW_VALUE_NONE; false if value is malformed
+bool to_node_data(const FlowValue& value, SharedNodeData& data) {
+    switch (value.type) {
+    case FLOW_VALUE_NONE:
+        data = nullptr;
+        return true;
+    case FLOW_VALUE_INT:
+        data = std::make_shared<detail::NodeData<int>>(static_cast<int>(value.as.int_value));
+        return true;
+    case FLOW_VALUE_DOUBLE:
+        data = std::make_shared<detail::NodeData<double>>(value.as.double_value);
+        return true;
+    case FLOW_VALUE_BOOL:
+        data = std::make_shared<detail::NodeData<bool>>(value.as.bool_value);
+        return true;
+    case FLOW_VALUE_STRING: {
+        const FlowBuffer& buffer = value.as.string_value;
+        if (!buffer.data && buffer.size > 0) {
+            return false;
+        }
+        data = std::make_shared<detail::NodeData<std::string>>(
+            buffer.data ? std::string(buffer.data, buffer.size) : std::string());
+        return true;
+    }
+    }
+    return false;
+}
+
+// false if the data has a type FlowValue cannot carry
+bool to_value(const SharedNodeData& data, FlowValue& value) {
+    value.type = FLOW_VALUE_NONE;
+    if (!data) {
+        return true;
+    }
+
+    const auto type = data->Type();
+    if (type == TypeName_v<int>) {
+        value.type = FLOW_VALUE_INT;
+        value.as.int_value =
+            static_cast<int32_t>(static_cast<detail::NodeData<int>*>(data.get())->Get());
+    } else if (type == TypeName_v<double>) {
+        value.type = FLOW_VALUE_DOUBLE;
+        value.as.double_value = static_cast<detail::NodeData<double>*>(data.get())->Get();
+    } else if (type == TypeName_v<bool>) {
+        value.type = FLOW_VALUE_BOOL;
+        value.as.bool_value = static_cast<detail::NodeData<bool>*>(data.get())->Get();
+    } else if (type == TypeName_v<std::string>) {
+        const std::string& str = static_cast<detail::NodeData<std::string>*>(data.get())->Get();
+        value.type = FLOW_VALUE_STRING;
+        value.as.string_value = {flow_ffi::copy_string(str), str.size()};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+FlowError invoke(const std::shared_ptr<flow_ffi::GraphRuntime>& runtime,
+                 const flow_ffi::GraphBindings& bindings, const FlowValue* inputs,
+                 FlowValue* outputs) {
+    for (size_t i = 0; i < bindings.outputs.size(); ++i) {
+        outputs[i].type = FLOW_VALUE_NONE;
+    }
+
+    flow_ffi::ExecutionContext context(runtime);
+    for (size_t i = 0; i < bindings.inputs.size(); ++i) {
+        SharedNodeData data;
+        if (!to_node_data(inputs[i], data)) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT, "Invalid argument: malformed input value " +
+                                                 std::to_string(i));
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+        if (!data) {
+            continue;
+        }
+        const auto& binding = bindings.inputs[i];
+        FlowError result = context.set_input(binding.node_id, binding.port_key, std::move(data));
+        if (result != FLOW_SUCCESS) {
+            return result;
+        }
+    }
+
+    FlowError result = context.run();
+    if (result != FLOW_SUCCESS) {
+        return result;
+    }
+
+    for (size_t i = 0; i < bindings.outputs.size(); ++i) {
+        const auto& binding = bindings.outputs[i];
+        SharedNodeData data = context.get_output(binding.node_id, binding.port_key);
+        if (!to_value(data, outputs[i])) {
+            flow_free_values(outputs, i);
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_TYPE_MISMATCH, "Output " + std::to_string(i) +
+                                              " has a type FlowValue cannot carry: " +
+                                              std::string(data->Type()));
+            return FLOW_ERROR_TYPE_MISMATCH;
+        }
+    }
+    return FLOW_SUCCESS;
+}
+
+} // namespace
+
+extern "C" {
+
+// ============================================================================
+// Execution Contexts
+// ============================================================================
+
+FLOW_FFI_EXPORT FlowContextHandle flow_graph_create_context(FlowGraphHandle graph) {
+    FLOW_API_CALL_HANDLE({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return nullptr;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return nullptr;
+        }
+
+        auto context = std::make_shared<flow_ffi::ExecutionContext>(std::move(runtime));
+        void* handle =
+            flow_ffi::create_handle<std::shared_ptr<flow_ffi::ExecutionContext>>(context);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return reinterpret_cast<FlowContextHandle>(handle);
+    });
+}
+
+FLOW_FFI_EXPORT void flow_context_destroy(FlowContextHandle context) {
+    FLOW_API_CALL_VOID({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return;
+        }
+
+        // The pool releases its own contexts; another release here would free the handle
+        // while the pool still hands it out
+        auto execution_context = get_context(context);
+        if (!execution_context) {
+            return;
+        }
+        if (execution_context->pool_owned()) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT,
+                "Context belongs to a pool; return it with flow_graph_pool_release");
+            return;
+        }
+
+        flow_ffi::release_handle(context);
+        flow_ffi::ErrorManager::instance().clear_error();
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_set_input(FlowContextHandle context, const char* node_id,
+                                                 const char* port_key, FlowNodeDataHandle data) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context") ||
+            !flow_ffi::validate_string(node_id, "node_id") ||
+            !flow_ffi::validate_string(port_key, "port_key")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        std::string id;
+        if (!get_node_id(node_id, id)) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        // Null data removes the value, so the node falls back to its own input again
+        SharedNodeData value;
+        if (data) {
+            auto* wrapper = flow_ffi::get_handle<NodeDataWrapper>(data);
+            if (!wrapper) {
+                flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                             "Invalid data handle");
+                return FLOW_ERROR_INVALID_HANDLE;
+            }
+            value = wrapper->data;
+        }
+
+        FlowError result = ctx->set_input(id, port_key, std::move(value));
+        if (result == FLOW_SUCCESS) {
+            flow_ffi::ErrorManager::instance().clear_error();
+        }
+        return result;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_run(FlowContextHandle context) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        FlowError result = ctx->run();
+        if (result == FLOW_SUCCESS) {
+            flow_ffi::ErrorManager::instance().clear_error();
+        }
+        return result;
+    });
+}
+
+FLOW_FFI_EXPORT FlowNodeDataHandle flow_context_get_output(FlowContextHandle context,
+                                                           const char* node_id,
+                                                           const char* port_key) {
+    FLOW_API_CALL_HANDLE({
+        if (!flow_ffi::validate_handle(context, "context") ||
+            !flow_ffi::validate_string(node_id, "node_id") ||
+            !flow_ffi::validate_string(port_key, "port_key")) {
+            return nullptr;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return nullptr;
+        }
+
+        std::string id;
+        if (!get_node_id(node_id, id)) {
+            return nullptr;
+        }
+
+        SharedNodeData data = ctx->get_output(id, port_key);
+        flow_ffi::ErrorManager::instance().clear_error();
+        if (!data) {
+            return nullptr; // Not computed in the last run
+        }
+        return reinterpret_cast<FlowNodeDataHandle>(
+            flow_ffi::create_handle<NodeDataWrapper>(NodeDataWrapper(std::move(data))));
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_clear(FlowContextHandle context) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        ctx->clear();
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_graph_set_sink(FlowGraphHandle graph, const char* node_id,
+                                              const char* port_key, bool is_sink) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        // Removing a sink needs no live port, its node may be gone already
+        flow_ffi::PortBinding sink;
+        if (is_sink) {
+            FlowError result =
+                resolve_binding(*runtime->plan(), FlowPortRef{node_id, port_key}, false, sink);
+            if (result != FLOW_SUCCESS) {
+                return result;
+            }
+        } else if (!flow_ffi::validate_string(node_id, "node_id") ||
+                   !flow_ffi::validate_string(port_key, "port_key") ||
+                   !get_node_id(node_id, sink.node_id)) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        } else {
+            sink.port_key = port_key;
+        }
+
+        runtime->set_sink(sink.node_id, sink.port_key, is_sink);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_set_dead_node_elimination(FlowContextHandle context,
+                                                                 bool enabled) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        ctx->set_eliminate_dead_nodes(enabled);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_set_constant_folding(FlowContextHandle context,
+                                                            bool enabled) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        ctx->set_constant_folding(enabled);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_set_parallelism(FlowContextHandle context,
+                                                       size_t max_threads) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        ctx->set_parallelism(max_threads);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_set_timeouts(FlowContextHandle context,
+                                                    uint64_t node_timeout_ms,
+                                                    uint64_t run_timeout_ms) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        ctx->set_timeouts(node_timeout_ms, run_timeout_ms);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_set_scheduling_policy(FlowContextHandle context,
+                                                             FlowSchedulingPolicy policy) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+        if (policy != FLOW_SCHEDULE_FIFO && policy != FLOW_SCHEDULE_CRITICAL_PATH) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
+                                                         "Unknown scheduling policy");
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        ctx->set_scheduling_policy(policy);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_graph_set_fusion_threshold(FlowGraphHandle graph,
+                                                          uint64_t max_task_cost_ns) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        runtime->set_fusion_threshold(max_task_cost_ns);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_graph_set_output_cache(FlowGraphHandle graph,
+                                                      const char* directory,
+                                                      uint64_t max_bytes,
+                                                      uint64_t min_compute_ns) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        std::shared_ptr<flow_ffi::OutputCache> cache;
+        if (directory) {
+            cache = flow_ffi::OutputCache::open(directory, max_bytes);
+            if (!cache) {
+                flow_ffi::ErrorManager::instance().set_error(
+                    FLOW_ERROR_INVALID_ARGUMENT,
+                    std::string("Cannot use output cache directory: ") + directory);
+                return FLOW_ERROR_INVALID_ARGUMENT;
+            }
+        }
+
+        runtime->set_output_cache(std::move(cache), min_compute_ns);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_context_get_run_stats(FlowContextHandle context,
+                                                     FlowRunStats* stats) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(context, "context") ||
+            !flow_ffi::validate_pointer(stats, "stats")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto ctx = get_context(context);
+        if (!ctx) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        *stats = ctx->last_run_stats();
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+// ============================================================================
+// Graph Pools
+// ============================================================================
+
+FLOW_FFI_EXPORT FlowGraphPoolHandle flow_graph_pool_create(FlowGraphHandle graph, size_t size) {
+    FLOW_API_CALL_HANDLE({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return nullptr;
+        }
+        if (size == 0) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
+                                                         "Pool size must be at least 1");
+            return nullptr;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return nullptr;
+        }
+
+        auto pool = std::make_shared<flow_ffi::ContextPool>(std::move(runtime), size);
+        void* handle = flow_ffi::create_handle<std::shared_ptr<flow_ffi::ContextPool>>(pool);
+        flow_ffi::ErrorManager::instance().clear_error();
+        return reinterpret_cast<FlowGraphPoolHandle>(handle);
+    });
+}
+
+FLOW_FFI_EXPORT void flow_graph_pool_destroy(FlowGraphPoolHandle pool) {
+    FLOW_API_CALL_VOID({
+        if (!flow_ffi::validate_handle(pool, "pool")) {
+            return;
+        }
+
+        flow_ffi::release_handle(pool);
+        flow_ffi::ErrorManager::instance().clear_error();
+    });
+}
+
+FLOW_FFI_EXPORT FlowContextHandle flow_graph_pool_acquire(FlowGraphPoolHandle pool,
+                                                          int64_t timeout_ms) {
+    FLOW_API_CALL_HANDLE({
+        if (!flow_ffi::validate_handle(pool, "pool")) {
+            return nullptr;
+        }
+
+        auto graph_pool = get_pool(pool);
+        if (!graph_pool) {
+            return nullptr;
+        }
+
+        void* context = graph_pool->acquire(timeout_ms);
+        if (!context) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_TIMEOUT,
+                "Timed out after " + std::to_string(timeout_ms) + " ms waiting for a context");
+            return nullptr;
+        }
+        flow_ffi::ErrorManager::instance().clear_error();
+        return reinterpret_cast<FlowContextHandle>(context);
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_graph_pool_release(FlowGraphPoolHandle pool,
+                                                  FlowContextHandle context) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(pool, "pool") ||
+            !flow_ffi::validate_handle(context, "context")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto graph_pool = get_pool(pool);
+        if (!graph_pool) {
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        if (!graph_pool->release(context)) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT, "Context is not checked out from this pool");
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT size_t flow_graph_pool_available(FlowGraphPoolHandle pool) {
+    FLOW_API_CALL_VALUE(0, {
+        if (!flow_ffi::validate_handle(pool, "pool")) {
+            return 0;
+        }
+
+        auto graph_pool = get_pool(pool);
+        return graph_pool ? graph_pool->available() : 0;
+    });
+}
+
+// ============================================================================
+// Function-style Invocation
+// ============================================================================
+
+FLOW_FFI_EXPORT FlowError flow_graph_set_bindings(FlowGraphHandle graph,
+                                                  const FlowPortRef* inputs, size_t input_count,
+                                                  const FlowPortRef* outputs,
+                                                  size_t output_count) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+        if ((input_count > 0 && !flow_ffi::validate_pointer(inputs, "inputs")) ||
+            (output_count > 0 && !flow_ffi::validate_pointer(outputs, "outputs"))) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        auto bindings = std::make_shared<flow_ffi::GraphBindings>();
+        FlowError result = make_bindings(*runtime->plan(), inputs, input_count, outputs,
+                                         output_count, *bindings);
+        if (result != FLOW_SUCCESS) {
+            return result;
+        }
+
+        runtime->set_bindings(std::move(bindings));
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_graph_invoke(FlowGraphHandle graph, const FlowValue* inputs,
+                                            FlowValue* outputs) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        auto bindings = runtime->bindings();
+        if (!bindings) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT,
+                "Invalid argument: graph has no bindings, call flow_graph_set_bindings first");
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+        if ((!bindings->inputs.empty() && !flow_ffi::validate_pointer(inputs, "inputs")) ||
+            (!bindings->outputs.empty() && !flow_ffi::validate_pointer(outputs, "outputs"))) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        FlowError result = invoke(runtime, *bindings, inputs, outputs);
+        if (result == FLOW_SUCCESS) {
+            flow_ffi::ErrorManager::instance().clear_error();
+        }
+        return result;
+    });
+}
+
+// ============================================================================
+// Lazy Evaluation
+// ============================================================================
+
+FLOW_FFI_EXPORT FlowNodeDataHandle flow_graph_evaluate(FlowGraphHandle graph, const char* node_id,
+                                                       const char* port_key) {
+    FLOW_API_CALL_HANDLE({
+        if (!flow_ffi::validate_handle(graph, "graph") ||
+            !flow_ffi::validate_string(node_id, "node_id") ||
+            !flow_ffi::validate_string(port_key, "port_key")) {
+            return nullptr;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return nullptr;
+        }
+
+        std::string id;
+        if (!get_node_id(node_id, id)) {
+            return nullptr;
+        }
+
+        SharedNodeData data;
+        if (runtime->evaluate(id, port_key, data) != FLOW_SUCCESS) {
+            return nullptr;
+        }
+        flow_ffi::ErrorManager::instance().clear_error();
+        if (!data) {
+            return nullptr; // An input of the cone has no value
+        }
+        return reinterpret_cast<FlowNodeDataHandle>(
+            flow_ffi::create_handle<NodeDataWrapper>(NodeDataWrapper(std::move(data))));
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_graph_clear_evaluation_cache(FlowGraphHandle graph) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto runtime = flow_ffi::GraphRuntime::for_graph(graph);
+        if (!runtime) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        runtime->clear_cache();
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+} // extern "C"
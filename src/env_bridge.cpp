@@ -3,11 +3,10 @@
 #include <flow/core/Env.hpp>
 #include <flow/core/NodeFactory.hpp>
 
-#include <cstring>
-
 #include "env_wrapper.hpp"
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "result_memory.hpp"
 
 using namespace flow;
 
@@ -114,9 +113,7 @@ FLOW_FFI_EXPORT const char* flow_env_get_var(FlowEnvHandle env, const char* name
             std::string value = env_wrapper->env->GetVar(name);
 
             // Allocate string that will be freed by flow_free_string
-            char* result = new char[value.length() + 1];
-            std::strcpy(result, value.c_str());
-            return result;
+            return flow_ffi::copy_string(value);
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
                 FLOW_ERROR_UNKNOWN, std::string("Failed to get environment variable: ") + e.what());
@@ -3,10 +3,13 @@
 #include "flow_ffi.h"
 
 #include <mutex>
+#include <new>
 #include <string>
 #include <thread>
 #include <unordered_map>
 
+#include "api_stats.hpp"
+
 namespace flow_ffi {
 
 // Thread-local error management
@@ -18,6 +21,7 @@ public:
     }
 
     void set_error(FlowError code, const std::string& message) {
+        ++thread_error_sequence();
         std::lock_guard<std::mutex> lock(mutex_);
         auto thread_id = std::this_thread::get_id();
         errors_[thread_id] = {code, message};
@@ -85,12 +89,17 @@ private:
     bool error_set_;
 };
 
-// Macro for safe API calls with exception handling
+// Macro for safe API calls with exception handling. Every variant also records the call
+// in the per-function statistics when flow_api_stats_enable is on.
 #define FLOW_API_CALL(code)                                                           \
     do {                                                                              \
+        flow_ffi::ApiCallRecorder api_call_recorder(__func__);                        \
         flow_ffi::ErrorSetter error_setter;                                           \
         try {                                                                         \
             code                                                                      \
+        } catch (const std::bad_alloc& e) {                                           \
+            error_setter.set_error(FLOW_ERROR_OUT_OF_MEMORY, e.what());               \
+            return FLOW_ERROR_OUT_OF_MEMORY;                                          \
         } catch (const std::exception& e) {                                           \
             error_setter.set_error(FLOW_ERROR_UNKNOWN, e.what());                     \
             return FLOW_ERROR_UNKNOWN;                                                \
@@ -103,9 +112,13 @@ private:
 // Macro for safe API calls that return handles
 #define FLOW_API_CALL_HANDLE(code)                                                    \
     do {                                                                              \
+        flow_ffi::ApiCallRecorder api_call_recorder(__func__);                        \
         flow_ffi::ErrorSetter error_setter;                                           \
         try {                                                                         \
             code                                                                      \
+        } catch (const std::bad_alloc& e) {                                           \
+            error_setter.set_error(FLOW_ERROR_OUT_OF_MEMORY, e.what());               \
+            return nullptr;                                                           \
         } catch (const std::exception& e) {                                           \
             error_setter.set_error(FLOW_ERROR_UNKNOWN, e.what());                     \
             return nullptr;                                                           \
@@ -118,9 +131,13 @@ private:
 // Macro for safe API calls that return void
 #define FLOW_API_CALL_VOID(code)                                                      \
     do {                                                                              \
+        flow_ffi::ApiCallRecorder api_call_recorder(__func__);                        \
         flow_ffi::ErrorSetter error_setter;                                           \
         try {                                                                         \
             code                                                                      \
+        } catch (const std::bad_alloc& e) {                                           \
+            error_setter.set_error(FLOW_ERROR_OUT_OF_MEMORY, e.what());               \
+            return;                                                                   \
         } catch (const std::exception& e) {                                           \
             error_setter.set_error(FLOW_ERROR_UNKNOWN, e.what());                     \
             return;                                                                   \
@@ -130,6 +147,25 @@ private:
         }                                                                             \
     } while (0)
 
+// Macro for safe API calls that return a plain value, fallback on an exception
+#define FLOW_API_CALL_VALUE(fallback, code)                                           \
+    do {                                                                              \
+        flow_ffi::ApiCallRecorder api_call_recorder(__func__);                        \
+        flow_ffi::ErrorSetter error_setter;                                           \
+        try {                                                                         \
+            code                                                                      \
+        } catch (const std::bad_alloc& e) {                                           \
+            error_setter.set_error(FLOW_ERROR_OUT_OF_MEMORY, e.what());               \
+            return fallback;                                                          \
+        } catch (const std::exception& e) {                                           \
+            error_setter.set_error(FLOW_ERROR_UNKNOWN, e.what());                     \
+            return fallback;                                                          \
+        } catch (...) {                                                               \
+            error_setter.set_error(FLOW_ERROR_UNKNOWN, "Unknown exception occurred"); \
+            return fallback;                                                          \
+        }                                                                             \
+    } while (0)
+
 // Validation helpers
 inline bool validate_handle(void* handle, const char* handle_name) {
     if (!handle) {
@@ -156,7 +192,7 @@ inline bool validate_string(const char* str, const char* param_name) {
     return true;
 }
 
-inline bool validate_pointer(void* ptr, const char* param_name) {
+inline bool validate_pointer(const void* ptr, const char* param_name) {
     if (!ptr) {
         ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
                                            std::string("Invalid argument: ") + param_name +
@@ -3,8 +3,10 @@
 
 #include "flow_ffi.h"
 
+#include "connection_wrapper.hpp"
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "node_wrapper.hpp"
 
 // Include flow-core headers
 #include <flow/core/Connection.hpp>
@@ -180,7 +182,7 @@ FlowEventRegistrationHandle flow_graph_on_nodes_connected(FlowGraphHandle graph,
             ->OnNodesConnected.Bind(
                 reg->event_id, [callback, user_data](const SharedConnection& conn) {
                     // Convert SharedConnection to handle and call Dart callback
-                    auto conn_handle = flow_ffi::create_handle<std::shared_ptr<Connection>>(conn);
+                    auto conn_handle = flow_ffi::create_handle<ConnectionWrapper>(conn);
                     callback(static_cast<FlowConnectionHandle>(conn_handle), user_data);
                 });
 
@@ -216,7 +218,7 @@ FlowEventRegistrationHandle flow_graph_on_nodes_disconnected(FlowGraphHandle gra
             ->OnNodesDisconnected.Bind(
                 reg->event_id, [callback, user_data](const SharedConnection& conn) {
                     // Convert SharedConnection to handle and call Dart callback
-                    auto conn_handle = flow_ffi::create_handle<std::shared_ptr<Connection>>(conn);
+                    auto conn_handle = flow_ffi::create_handle<ConnectionWrapper>(conn);
                     callback(static_cast<FlowConnectionHandle>(conn_handle), user_data);
                 });
 
@@ -268,7 +270,8 @@ FlowEventRegistrationHandle flow_node_on_compute(FlowNodeHandle node,
         }
 
         auto* node_ptr = flow_ffi::get_handle<std::shared_ptr<Node>>(node);
-        if (!node_ptr || !*node_ptr) {
+        SharedNode target = node_ptr ? flow_ffi::load_node(*node_ptr) : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get node from handle");
             return nullptr;
@@ -280,7 +283,7 @@ FlowEventRegistrationHandle flow_node_on_compute(FlowNodeHandle node,
         auto* reg = reinterpret_cast<FlowEventRegistration*>(registration);
 
         // Bind to the node's OnCompute event
-        (*node_ptr)->OnCompute.Bind(reg->event_id,
+        target->OnCompute.Bind(reg->event_id,
                                     [callback, user_data, node]() { callback(node, user_data); });
 
         flow_ffi::ErrorManager::instance().clear_error();
@@ -298,7 +301,8 @@ FlowEventRegistrationHandle flow_node_on_error(FlowNodeHandle node, FlowErrorEve
         }
 
         auto* node_ptr = flow_ffi::get_handle<std::shared_ptr<Node>>(node);
-        if (!node_ptr || !*node_ptr) {
+        SharedNode target = node_ptr ? flow_ffi::load_node(*node_ptr) : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get node from handle");
             return nullptr;
@@ -310,7 +314,7 @@ FlowEventRegistrationHandle flow_node_on_error(FlowNodeHandle node, FlowErrorEve
         auto* reg = reinterpret_cast<FlowEventRegistration*>(registration);
 
         // Bind to the node's OnError event
-        (*node_ptr)->OnError.Bind(reg->event_id,
+        target->OnError.Bind(reg->event_id,
                                   [callback, user_data](const std::exception& error) {
                                       callback(error.what(), user_data);
                                   });
@@ -330,7 +334,8 @@ flow_node_on_set_input(FlowNodeHandle node, FlowNodeDataEventCallback callback,
         }
 
         auto* node_ptr = flow_ffi::get_handle<std::shared_ptr<Node>>(node);
-        if (!node_ptr || !*node_ptr) {
+        SharedNode target = node_ptr ? flow_ffi::load_node(*node_ptr) : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get node from handle");
             return nullptr;
@@ -342,7 +347,7 @@ flow_node_on_set_input(FlowNodeHandle node, FlowNodeDataEventCallback callback,
         auto* reg = reinterpret_cast<FlowEventRegistration*>(registration);
 
         // Bind to the node's OnSetInput event
-        (*node_ptr)->OnSetInput.Bind(
+        target->OnSetInput.Bind(
             reg->event_id,
             [callback, user_data, node](const IndexableName& port_key, const SharedNodeData& data) {
                 // Convert data to handle
@@ -367,7 +372,8 @@ flow_node_on_set_output(FlowNodeHandle node, FlowNodeDataEventCallback callback,
         }
 
         auto* node_ptr = flow_ffi::get_handle<std::shared_ptr<Node>>(node);
-        if (!node_ptr || !*node_ptr) {
+        SharedNode target = node_ptr ? flow_ffi::load_node(*node_ptr) : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Failed to get node from handle");
             return nullptr;
@@ -379,7 +385,7 @@ flow_node_on_set_output(FlowNodeHandle node, FlowNodeDataEventCallback callback,
         auto* reg = reinterpret_cast<FlowEventRegistration*>(registration);
 
         // Bind to the node's OnSetOutput event
-        (*node_ptr)->OnSetOutput.Bind(
+        target->OnSetOutput.Bind(
             reg->event_id,
             [callback, user_data, node](const IndexableName& port_key, const SharedNodeData& data) {
                 // Convert data to handle
@@ -441,19 +447,20 @@ FlowError flow_event_unregister(FlowEventRegistrationHandle registration) {
             case FlowEventRegistration::Type::NodeSetInput:
             case FlowEventRegistration::Type::NodeSetOutput: {
                 auto* node_ptr = flow_ffi::get_handle<std::shared_ptr<Node>>(reg->handle);
-                if (node_ptr && *node_ptr) {
+                SharedNode target = node_ptr ? flow_ffi::load_node(*node_ptr) : nullptr;
+                if (target) {
                     switch (reg->type) {
                         case FlowEventRegistration::Type::NodeCompute:
-                            (*node_ptr)->OnCompute.Unbind(reg->event_id);
+                            target->OnCompute.Unbind(reg->event_id);
                             break;
                         case FlowEventRegistration::Type::NodeError:
-                            (*node_ptr)->OnError.Unbind(reg->event_id);
+                            target->OnError.Unbind(reg->event_id);
                             break;
                         case FlowEventRegistration::Type::NodeSetInput:
-                            (*node_ptr)->OnSetInput.Unbind(reg->event_id);
+                            target->OnSetInput.Unbind(reg->event_id);
                             break;
                         case FlowEventRegistration::Type::NodeSetOutput:
-                            (*node_ptr)->OnSetOutput.Unbind(reg->event_id);
+                            target->OnSetOutput.Unbind(reg->event_id);
                             break;
                         default:
                             break;
@@ -5,20 +5,18 @@
 #include <flow/core/NodeFactory.hpp>
 
 #include <cstring>
+#include <set>
 
 #include "env_wrapper.hpp"
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "module_wrapper.hpp"
+#include "node_wrapper.hpp"
+#include "result_memory.hpp"
+#include "string_interner.hpp"
 
 using namespace flow;
 
-// Wrapper structure for Node
-struct NodeWrapper {
-    SharedNode node;
-
-    NodeWrapper(SharedNode n) : node(std::move(n)) {}
-};
-
 extern "C" {
 
 FLOW_FFI_EXPORT FlowNodeHandle flow_factory_create_node(FlowNodeFactoryHandle factory,
@@ -61,6 +59,10 @@ FLOW_FFI_EXPORT FlowNodeHandle flow_factory_create_node(FlowNodeFactoryHandle fa
 
             auto node = factory_wrapper->factory->CreateNode(class_name, node_uuid, node_name,
                                                              env_wrapper->env);
+            if (!node && flow_ffi::resolve_lazy_node_class(factory_wrapper->factory, class_name)) {
+                node = factory_wrapper->factory->CreateNode(class_name, node_uuid, node_name,
+                                                            env_wrapper->env);
+            }
 
             if (!node) {
                 flow_ffi::ErrorManager::instance().set_error(
@@ -109,6 +111,10 @@ FLOW_FFI_EXPORT FlowError flow_factory_get_categories(FlowNodeFactoryHandle fact
             for (const auto& pair : category_map) {
                 unique_categories.insert(pair.first);
             }
+            for (const auto& entry :
+                 flow_ffi::lazy_node_classes(factory_wrapper->factory.get())) {
+                unique_categories.insert(entry.category);
+            }
 
             *count = unique_categories.size();
             if (*count == 0) {
@@ -116,13 +122,12 @@ FLOW_FFI_EXPORT FlowError flow_factory_get_categories(FlowNodeFactoryHandle fact
                 return FLOW_SUCCESS;
             }
 
-            // Allocate array of string pointers
-            *categories = new char*[*count];
+            // Allocate array of string pointers; the names themselves are interned
+            *categories = flow_ffi::alloc_array<char*>(*count);
 
             size_t i = 0;
             for (const auto& category : unique_categories) {
-                (*categories)[i] = new char[category.length() + 1];
-                std::strcpy((*categories)[i], category.c_str());
+                (*categories)[i] = const_cast<char*>(flow_ffi::intern(category));
                 ++i;
             }
 
@@ -169,6 +174,13 @@ FLOW_FFI_EXPORT FlowError flow_factory_get_node_classes(FlowNodeFactoryHandle fa
             for (auto it = range.first; it != range.second; ++it) {
                 class_names.push_back(it->second);
             }
+            // Deferred modules contribute placeholders until they are materialized
+            for (const auto& entry :
+                 flow_ffi::lazy_node_classes(factory_wrapper->factory.get())) {
+                if (entry.category == category) {
+                    class_names.push_back(entry.class_name);
+                }
+            }
 
             *count = class_names.size();
             if (*count == 0) {
@@ -176,12 +188,11 @@ FLOW_FFI_EXPORT FlowError flow_factory_get_node_classes(FlowNodeFactoryHandle fa
                 return FLOW_SUCCESS;
             }
 
-            // Allocate array of string pointers
-            *classes = new char*[*count];
+            // Allocate array of string pointers; the names themselves are interned
+            *classes = flow_ffi::alloc_array<char*>(*count);
 
             for (size_t i = 0; i < *count; ++i) {
-                (*classes)[i] = new char[class_names[i].length() + 1];
-                std::strcpy((*classes)[i], class_names[i].c_str());
+                (*classes)[i] = const_cast<char*>(flow_ffi::intern(class_names[i]));
             }
 
             return FLOW_SUCCESS;
@@ -215,9 +226,7 @@ FLOW_FFI_EXPORT const char* flow_factory_get_friendly_name(FlowNodeFactoryHandle
             std::string friendly_name = factory_wrapper->factory->GetFriendlyName(class_name);
 
             // Allocate string that will be freed by flow_free_string
-            char* result = new char[friendly_name.length() + 1];
-            std::strcpy(result, friendly_name.c_str());
-            return result;
+            return flow_ffi::copy_string(friendly_name);
 
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -2,6 +2,7 @@
 
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "result_memory.hpp"
 
 // Placeholder implementations - will be completed in subsequent phases
 
@@ -12,9 +13,8 @@ extern "C" {
 // ============================================================================
 
 FLOW_FFI_EXPORT void flow_free_string(char* str) {
-    if (str) {
-        delete[] str;
-    }
+    // Interned, handle-owned and arena strings are not heap copies; freeing them is a no-op
+    flow_ffi::free_string(str);
 }
 
 FLOW_FFI_EXPORT void flow_free_string_array(char** array, size_t count) {
@@ -22,14 +22,12 @@ FLOW_FFI_EXPORT void flow_free_string_array(char** array, size_t count) {
         for (size_t i = 0; i < count; ++i) {
             flow_free_string(array[i]);
         }
-        delete[] array;
+        flow_ffi::free_array(array);
     }
 }
 
 FLOW_FFI_EXPORT void flow_free_handle_array(void** array) {
-    if (array) {
-        delete[] array;
-    }
+    flow_ffi::free_array(array);
 }
 
 FLOW_FFI_EXPORT void flow_free_connection_array(FlowConnectionInfo* connections, size_t count) {
@@ -41,10 +39,52 @@ FLOW_FFI_EXPORT void flow_free_connection_array(FlowConnectionInfo* connections,
             flow_free_string(const_cast<char*>(connections[i].target_node_id));
             flow_free_string(const_cast<char*>(connections[i].target_port_key));
         }
-        delete[] connections;
+        flow_ffi::free_array(connections);
+    }
+}
+
+FLOW_FFI_EXPORT void flow_free_values(FlowValue* values, size_t count) {
+    if (values) {
+        for (size_t i = 0; i < count; ++i) {
+            if (values[i].type == FLOW_VALUE_STRING) {
+                flow_free_string(const_cast<char*>(values[i].as.string_value.data));
+            }
+            values[i].type = FLOW_VALUE_NONE;
+        }
     }
 }
 
+FLOW_FFI_EXPORT FlowError flow_set_allocator(FlowAllocFn alloc_fn, FlowFreeFn free_fn,
+                                             void* user_data) {
+    FLOW_API_CALL({
+        if ((alloc_fn == nullptr) != (free_fn == nullptr)) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT,
+                "Invalid argument: alloc_fn and free_fn must both be set or both be null");
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        flow_ffi::set_allocator(alloc_fn, free_fn, user_data);
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT void flow_result_arena_enable(bool enabled) {
+    flow_ffi::set_result_arena_enabled(enabled);
+}
+
+FLOW_FFI_EXPORT bool flow_result_arena_is_enabled(void) {
+    return flow_ffi::result_arena_enabled();
+}
+
+FLOW_FFI_EXPORT void flow_result_arena_reset(void) {
+    flow_ffi::reset_result_arena();
+}
+
+FLOW_FFI_EXPORT size_t flow_result_arena_bytes_used(void) {
+    return flow_ffi::result_arena_bytes_used();
+}
+
 // ============================================================================
 // Placeholder implementations (to be completed in subsequent phases)
 // ============================================================================
@@ -3,9 +3,14 @@
 
 #include "flow_ffi.h"
 
+#include "connection_wrapper.hpp"
 #include "env_wrapper.hpp"
 #include "error_handling.hpp"
+#include "graph_snapshot.hpp"
 #include "handle_manager.hpp"
+#include "module_wrapper.hpp"
+#include "node_wrapper.hpp"
+#include "result_memory.hpp"
 
 // Include flow-core headers
 #include <flow/core/Connection.hpp>
@@ -16,7 +21,7 @@
 #include <flow/core/UUID.hpp>
 
 // Include JSON support
-#include <cstring>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -24,11 +29,24 @@
 
 using namespace flow;
 
-// Wrapper structure for Node (consistent with factory_bridge.cpp)
-struct NodeWrapper {
-    SharedNode node;
-    NodeWrapper(SharedNode n) : node(std::move(n)) {}
-};
+namespace {
+
+// Node classes a saved graph refers to, in its "nodes" entries
+std::vector<std::string> saved_node_classes(const nlohmann::json& j) {
+    std::set<std::string> classes;
+    auto nodes = j.find("nodes");
+    if (j.is_object() && nodes != j.end() && (nodes->is_array() || nodes->is_object())) {
+        for (const auto& node : *nodes) {
+            auto class_name = node.is_object() ? node.find("class") : node.end();
+            if (node.is_object() && class_name != node.end() && class_name->is_string()) {
+                classes.insert(class_name->get<std::string>());
+            }
+        }
+    }
+    return {classes.begin(), classes.end()};
+}
+
+} // namespace
 
 extern "C" {
 
@@ -59,8 +77,9 @@ FLOW_FFI_EXPORT FlowGraphHandle flow_graph_create(FlowEnvHandle env) {
         // Create graph with default name and the provided environment
         auto graph = std::make_shared<Graph>("Default Graph", env_wrapper->env);
 
-        // Create handle wrapper
-        auto handle = flow_ffi::create_handle<std::shared_ptr<Graph>>(std::move(graph));
+        // Create handle wrapper, carrying the topology snapshot state
+        auto handle = flow_ffi::HandleRegistry::instance().register_handle(
+            std::make_unique<flow_ffi::GraphHandle>(std::move(graph)));
         flow_ffi::ErrorManager::instance().clear_error();
         return static_cast<FlowGraphHandle>(handle);
     });
@@ -103,6 +122,9 @@ FLOW_FFI_EXPORT FlowNodeHandle flow_graph_add_node(FlowGraphHandle graph, const
 
         // Step 1: Create the node using the factory (proper two-step workflow)
         auto node = factory->CreateNode(class_id, UUID(), name, (*graph_ptr)->GetEnv());
+        if (!node && flow_ffi::resolve_lazy_node_class(factory, class_id)) {
+            node = factory->CreateNode(class_id, UUID(), name, (*graph_ptr)->GetEnv());
+        }
         if (!node) {
             flow_ffi::ErrorManager::instance().set_error(
                 FLOW_ERROR_NODE_NOT_FOUND,
@@ -111,6 +133,7 @@ FLOW_FFI_EXPORT FlowNodeHandle flow_graph_add_node(FlowGraphHandle graph, const
         }
 
         // Step 2: Add the pre-created node to the graph (as expected by flow-core)
+        flow_ffi::GraphWriteGuard write_guard(flow_ffi::get_graph_topology(graph));
         (*graph_ptr)->AddNode(node);
 
         // Verify node was added successfully by checking if we can retrieve it
@@ -154,6 +177,7 @@ FLOW_FFI_EXPORT FlowError flow_graph_remove_node(FlowGraphHandle graph, const ch
         }
 
         // Remove node from graph
+        flow_ffi::GraphWriteGuard write_guard(flow_ffi::get_graph_topology(graph));
         (*graph_ptr)->RemoveNodeByID(uuid);
 
         flow_ffi::ErrorManager::instance().clear_error();
@@ -185,8 +209,10 @@ FLOW_FFI_EXPORT FlowNodeHandle flow_graph_get_node(FlowGraphHandle graph, const
             return nullptr;
         }
 
-        // Get node from graph
-        auto node = (*graph_ptr)->GetNode(uuid);
+        // Get node from the topology snapshot
+        auto snapshot = flow_ffi::graph_snapshot(graph, **graph_ptr);
+        auto it = snapshot->node_index.find(std::string(uuid));
+        SharedNode node = it != snapshot->node_index.end() ? snapshot->nodes[it->second] : nullptr;
         if (!node) {
             flow_ffi::ErrorManager::instance().set_error(
                 FLOW_ERROR_NODE_NOT_FOUND, std::string("Node not found with ID: ") + node_id);
@@ -217,8 +243,8 @@ FLOW_FFI_EXPORT FlowError flow_graph_get_nodes(FlowGraphHandle graph, FlowNodeHa
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        const auto& node_map = (*graph_ptr)->GetNodes();
-        *count = node_map.size();
+        auto snapshot = flow_ffi::graph_snapshot(graph, **graph_ptr);
+        *count = snapshot->nodes.size();
 
         if (*count == 0) {
             *nodes = nullptr;
@@ -227,10 +253,10 @@ FLOW_FFI_EXPORT FlowError flow_graph_get_nodes(FlowGraphHandle graph, FlowNodeHa
         }
 
         // Allocate array for node handles
-        *nodes = new FlowNodeHandle[*count];
+        *nodes = flow_ffi::alloc_array<FlowNodeHandle>(*count);
 
         size_t i = 0;
-        for (const auto& [uuid, node] : node_map) {
+        for (const auto& node : snapshot->nodes) {
             auto wrapper = NodeWrapper(node);
             auto handle = flow_ffi::create_handle<NodeWrapper>(wrapper);
             (*nodes)[i++] = static_cast<FlowNodeHandle>(handle);
@@ -275,6 +301,7 @@ FLOW_FFI_EXPORT FlowConnectionHandle flow_graph_connect_nodes(FlowGraphHandle gr
         }
 
         // Create connection
+        flow_ffi::GraphWriteGuard write_guard(flow_ffi::get_graph_topology(graph));
         auto connection = (*graph_ptr)
                               ->ConnectNodes(source_uuid, IndexableName(source_port), target_uuid,
                                              IndexableName(target_port));
@@ -286,7 +313,7 @@ FLOW_FFI_EXPORT FlowConnectionHandle flow_graph_connect_nodes(FlowGraphHandle gr
         }
 
         // Create handle for the connection
-        auto handle = flow_ffi::create_handle<SharedConnection>(std::move(connection));
+        auto handle = flow_ffi::create_handle<ConnectionWrapper>(std::move(connection));
         flow_ffi::ErrorManager::instance().clear_error();
         return static_cast<FlowConnectionHandle>(handle);
     } catch (const std::exception& e) {
@@ -324,6 +351,7 @@ FLOW_FFI_EXPORT FlowError flow_graph_disconnect_nodes(FlowGraphHandle graph,
         }
 
         // Find the connection in the graph by iterating through all connections
+        flow_ffi::GraphWriteGuard write_guard(flow_ffi::get_graph_topology(graph));
         const auto& connections = (*graph_ptr)->GetConnections();
         SharedConnection connection = nullptr;
 
@@ -386,6 +414,7 @@ FLOW_FFI_EXPORT FlowError flow_graph_clear(FlowGraphHandle graph) {
         }
 
         // Clear all nodes and connections
+        flow_ffi::GraphWriteGuard write_guard(flow_ffi::get_graph_topology(graph));
         (*graph_ptr)->Clear();
 
         flow_ffi::ErrorManager::instance().clear_error();
@@ -412,8 +441,7 @@ FLOW_FFI_EXPORT char* flow_graph_save_to_json(FlowGraphHandle graph) {
         std::string json_str = j.dump(2);
 
         // Allocate C string
-        char* result = new char[json_str.length() + 1];
-        std::strcpy(result, json_str.c_str());
+        char* result = flow_ffi::copy_string(json_str);
 
         flow_ffi::ErrorManager::instance().clear_error();
         return result;
@@ -437,6 +465,20 @@ FLOW_FFI_EXPORT FlowError flow_graph_load_from_json(FlowGraphHandle graph, const
         try {
             // Parse JSON and restore graph state
             nlohmann::json j = nlohmann::json::parse(json_str);
+
+            // from_json creates nodes straight from the factory, so classes of deferred
+            // (lazy or indexed) modules must be registered first, and the graph is left
+            // untouched if a class is still unknown
+            if (auto factory = (*graph_ptr)->GetEnv()->GetFactory()) {
+                auto missing = flow_ffi::resolve_lazy_node_classes(factory, saved_node_classes(j));
+                if (!missing.empty()) {
+                    flow_ffi::ErrorManager::instance().set_error(
+                        FLOW_ERROR_NODE_NOT_FOUND, "Unknown node class: " + missing.front());
+                    return FLOW_ERROR_NODE_NOT_FOUND;
+                }
+            }
+
+            flow_ffi::GraphWriteGuard write_guard(flow_ffi::get_graph_topology(graph));
             from_json(j, **graph_ptr);
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -467,8 +509,8 @@ FLOW_FFI_EXPORT FlowError flow_graph_get_connections(FlowGraphHandle graph,
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        const auto& graph_connections = (*graph_ptr)->GetConnections();
-        *count = graph_connections.Size();
+        auto snapshot = flow_ffi::graph_snapshot(graph, **graph_ptr);
+        *count = snapshot->connections.size();
 
         if (*count == 0) {
             *connections = nullptr;
@@ -477,37 +519,20 @@ FLOW_FFI_EXPORT FlowError flow_graph_get_connections(FlowGraphHandle graph,
         }
 
         // Allocate array of FlowConnectionInfo structs
-        *connections = new FlowConnectionInfo[*count];
+        *connections = flow_ffi::alloc_array<FlowConnectionInfo>(*count);
 
         size_t index = 0;
-        for (const auto& conn_pair : graph_connections) {
-            const auto& conn = conn_pair.second;
-            // Convert UUIDs to strings and allocate memory
-            auto id_str = std::string(conn->ID());
-            auto start_id_str = std::string(conn->StartNodeID());
-            auto end_id_str = std::string(conn->EndNodeID());
-            auto start_port_str = std::string(conn->StartPortKey());
-            auto end_port_str = std::string(conn->EndPortKey());
-
-            // Manually allocate C strings
-            (*connections)[index].id = new char[id_str.length() + 1];
-            std::strcpy(const_cast<char*>((*connections)[index].id), id_str.c_str());
-
-            (*connections)[index].source_node_id = new char[start_id_str.length() + 1];
-            std::strcpy(const_cast<char*>((*connections)[index].source_node_id),
-                        start_id_str.c_str());
-
-            (*connections)[index].source_port_key = new char[start_port_str.length() + 1];
-            std::strcpy(const_cast<char*>((*connections)[index].source_port_key),
-                        start_port_str.c_str());
-
-            (*connections)[index].target_node_id = new char[end_id_str.length() + 1];
-            std::strcpy(const_cast<char*>((*connections)[index].target_node_id),
-                        end_id_str.c_str());
-
-            (*connections)[index].target_port_key = new char[end_port_str.length() + 1];
-            std::strcpy(const_cast<char*>((*connections)[index].target_port_key),
-                        end_port_str.c_str());
+        for (const auto& record : snapshot->connections) {
+            // Allocate C strings
+            (*connections)[index].id = flow_ffi::copy_string(record.id);
+
+            (*connections)[index].source_node_id = flow_ffi::copy_string(record.source_node_id);
+
+            (*connections)[index].source_port_key = flow_ffi::copy_string(record.source_port);
+
+            (*connections)[index].target_node_id = flow_ffi::copy_string(record.target_node_id);
+
+            (*connections)[index].target_port_key = flow_ffi::copy_string(record.target_port);
 
             index++;
         }
@@ -517,6 +542,69 @@ FLOW_FFI_EXPORT FlowError flow_graph_get_connections(FlowGraphHandle graph,
     });
 }
 
+FLOW_FFI_EXPORT FlowError flow_graph_get_neighbors(FlowGraphHandle graph, const char* node_id,
+                                                   FlowNeighborDirection direction,
+                                                   char*** node_ids, size_t* count) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph") ||
+            !flow_ffi::validate_string(node_id, "node_id") ||
+            !flow_ffi::validate_pointer(node_ids, "node_ids") ||
+            !flow_ffi::validate_pointer(count, "count")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto* graph_ptr = flow_ffi::get_handle<std::shared_ptr<Graph>>(graph);
+        if (!graph_ptr || !*graph_ptr) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Failed to get graph from handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        UUID uuid;
+        try {
+            uuid = UUID(node_id);
+        } catch (const std::exception& e) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT, std::string("Invalid UUID format: ") + e.what());
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto snapshot = flow_ffi::graph_snapshot(graph, **graph_ptr);
+        auto it = snapshot->node_index.find(std::string(uuid));
+        if (it == snapshot->node_index.end()) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_NODE_NOT_FOUND, std::string("Node not found with ID: ") + node_id);
+            return FLOW_ERROR_NODE_NOT_FOUND;
+        }
+
+        const auto& neighbors = direction == FLOW_NEIGHBORS_UPSTREAM
+                                    ? snapshot->upstream[it->second]
+                                    : snapshot->downstream[it->second];
+        *count = neighbors.size();
+        *node_ids = nullptr;
+        if (!neighbors.empty()) {
+            *node_ids = flow_ffi::alloc_array<char*>(neighbors.size());
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                (*node_ids)[i] = flow_ffi::copy_string(snapshot->node_ids[neighbors[i]]);
+            }
+        }
+
+        flow_ffi::ErrorManager::instance().clear_error();
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT uint64_t flow_graph_get_topology_version(FlowGraphHandle graph) {
+    FLOW_API_CALL_VALUE(0, {
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return 0;
+        }
+
+        auto topology = flow_ffi::get_graph_topology(graph);
+        return topology ? topology->version() : 0;
+    });
+}
+
 FLOW_FFI_EXPORT bool flow_graph_can_connect(FlowGraphHandle graph, const char* source_id,
                                             const char* source_port, const char* target_id,
                                             const char* target_port) {
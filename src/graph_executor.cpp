@@ -0,0 +1,1275 @@
+#include "graph_executor.hpp"
+
+#include <flow/core/Env.hpp>
+#include <flow/core/IndexableName.hpp>
+#include <flow/core/NodeFactory.hpp>
+#include <flow/core/UUID.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include "error_handling.hpp"
+#include "module_wrapper.hpp"
+
+using namespace flow;
+
+namespace flow_ffi {
+
+namespace {
+
+std::vector<std::string> port_keys(const std::unordered_map<IndexableName, SharedPort>& ports) {
+    std::vector<std::string> keys;
+    keys.reserve(ports.size());
+    for (const auto& [key, port] : ports) {
+        keys.emplace_back(std::string(key));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+}
+
+// Threads shared by every parallel run. The thread calling a run always takes part or
+// watches, so a run completes or times out even while all of these are busy.
+//
+// Never destroyed: a node stuck at exit must not block it.
+class HelperThreads {
+public:
+    static HelperThreads& instance() {
+        static auto* threads = new HelperThreads(std::max(1u, std::thread::hardware_concurrency()));
+        return *threads;
+    }
+
+    void submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        available_.notify_one();
+    }
+
+    // Adds a thread in place of one held by an abandoned job. The first thread to finish
+    // a job after that exits again, so the pool returns to its size once the job returns.
+    void replace_stuck_thread() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++surplus_;
+        }
+        std::thread([this] { work(); }).detach();
+    }
+
+private:
+    explicit HelperThreads(unsigned count) {
+        for (unsigned i = 0; i < count; ++i) {
+            std::thread([this] { work(); }).detach();
+        }
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            available_.wait(lock, [this] { return !jobs_.empty(); });
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+            if (surplus_ > 0) {
+                --surplus_;
+                return;
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::function<void()>> jobs_;
+    std::size_t surplus_ = 0;
+};
+
+} // namespace
+
+bool gather_inputs(const GraphSnapshot& snapshot, const ExecutionPlan::Step& step,
+                   const InputOverrides* overrides, const std::vector<const PortValues*>& outputs,
+                   PortValues& inputs) {
+    const auto& node = snapshot.nodes[step.node];
+    const auto& id = snapshot.node_ids[step.node];
+
+    // Values set by the caller win, then upstream outputs of this run for connected ports,
+    // then whatever the graph's own node holds as configuration
+    for (const auto& port : step.input_ports) {
+        SharedNodeData value;
+        auto set = overrides ? overrides->find({id, port}) : InputOverrides::const_iterator();
+        auto connected =
+            std::find_if(step.inputs.begin(), step.inputs.end(),
+                         [&port](const auto& in) { return in.target_port == port; });
+        if (overrides && set != overrides->end()) {
+            value = set->second;
+        } else if (connected != step.inputs.end()) {
+            if (const PortValues* source = outputs[connected->source]) {
+                auto data = source->find(connected->source_port);
+                value = data != source->end() ? data->second : nullptr;
+            }
+        } else {
+            value = node->GetInputData(IndexableName(port));
+        }
+
+        if (!value) {
+            return false; // Like flow-core, a node missing an input is not computed
+        }
+        inputs.emplace(port, std::move(value));
+    }
+    return true;
+}
+
+std::shared_ptr<const ExecutionPlan> compile_plan(SharedGraphSnapshot snapshot) {
+    auto plan = std::make_shared<ExecutionPlan>();
+    const std::size_t node_count = snapshot->nodes.size();
+
+    // Kahn's algorithm, seeded in snapshot order so plans are deterministic
+    std::vector<std::size_t> in_degree(node_count);
+    std::deque<std::size_t> ready;
+    for (std::size_t i = 0; i < node_count; ++i) {
+        in_degree[i] = snapshot->upstream[i].size();
+        if (in_degree[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    std::vector<std::size_t> order;
+    order.reserve(node_count);
+    while (!ready.empty()) {
+        std::size_t index = ready.front();
+        ready.pop_front();
+        order.push_back(index);
+        for (std::size_t next : snapshot->downstream[index]) {
+            if (--in_degree[next] == 0) {
+                ready.push_back(next);
+            }
+        }
+    }
+
+    if (order.size() != node_count) {
+        plan->acyclic = false;
+        plan->snapshot = std::move(snapshot);
+        return plan;
+    }
+
+    plan->steps.reserve(node_count);
+    plan->step_of.resize(node_count);
+    for (std::size_t index : order) {
+        const auto& node = snapshot->nodes[index];
+        plan->step_of[index] = plan->steps.size();
+        plan->steps.push_back(
+            {index, {}, port_keys(node->GetInputPorts()), port_keys(node->GetOutputPorts())});
+    }
+
+    for (const auto& connection : snapshot->connections) {
+        auto source = snapshot->node_index.find(connection.source_node_id);
+        auto target = snapshot->node_index.find(connection.target_node_id);
+        if (source == snapshot->node_index.end() || target == snapshot->node_index.end()) {
+            continue;
+        }
+        plan->steps[plan->step_of[target->second]].inputs.push_back(
+            {source->second, connection.source_port, connection.target_port});
+    }
+
+    // Nodes without inputs may be generators, so only fixed inputs make a step constant
+    for (auto& step : plan->steps) {
+        step.constant = !step.input_ports.empty() &&
+                        std::all_of(step.inputs.begin(), step.inputs.end(), [&](const auto& in) {
+                            return plan->steps[plan->step_of[in.source]].constant;
+                        });
+    }
+
+    plan->snapshot = std::move(snapshot);
+    return plan;
+}
+
+TaskGraph build_task_graph(const ExecutionPlan& plan,
+                           const std::function<uint64_t(std::size_t)>& node_cost,
+                           uint64_t fusion_threshold_ns) {
+    const auto& snapshot = *plan.snapshot;
+    TaskGraph graph;
+    std::vector<std::size_t> task_of(snapshot.nodes.size());
+
+    for (std::size_t i = 0; i < plan.steps.size(); ++i) {
+        const std::size_t node = plan.steps[i].node;
+        const uint64_t cost = node_cost(node);
+
+        // A node with one upstream node that feeds nothing else continues that node's
+        // task, which it then ends, as long as the task stays under the threshold
+        const auto& upstream = snapshot.upstream[node];
+        if (fusion_threshold_ns > 0 && upstream.size() == 1 &&
+            snapshot.downstream[upstream[0]].size() == 1) {
+            auto& task = graph.tasks[task_of[upstream[0]]];
+            if (task.cost_ns + cost <= fusion_threshold_ns) {
+                task.steps.push_back(i);
+                task.cost_ns += cost;
+                task_of[node] = task_of[upstream[0]];
+                continue;
+            }
+        }
+
+        task_of[node] = graph.tasks.size();
+        graph.tasks.push_back({{i}, {}, 0, cost});
+    }
+
+    for (std::size_t t = 0; t < graph.tasks.size(); ++t) {
+        auto& task = graph.tasks[t];
+        for (std::size_t step : task.steps) {
+            for (std::size_t next : snapshot.downstream[plan.steps[step].node]) {
+                std::size_t next_task = task_of[next];
+                if (next_task != t &&
+                    std::find(task.next.begin(), task.next.end(), next_task) == task.next.end()) {
+                    task.next.push_back(next_task);
+                    ++graph.tasks[next_task].dependencies;
+                }
+            }
+        }
+    }
+
+    // Tasks only feed tasks created after them, so one backward pass sees every
+    // successor's path first. Each node adds 1 ns, which makes the path length decide
+    // while nothing is measured yet.
+    for (std::size_t t = graph.tasks.size(); t-- > 0;) {
+        auto& task = graph.tasks[t];
+        uint64_t downstream = 0;
+        for (std::size_t next : task.next) {
+            downstream = std::max(downstream, graph.tasks[next].critical_path_ns);
+        }
+        task.critical_path_ns = task.cost_ns + task.steps.size() + downstream;
+    }
+
+    for (std::size_t t = 0; t < graph.tasks.size(); ++t) {
+        if (graph.tasks[t].dependencies == 0) {
+            graph.roots.push_back(t);
+        }
+    }
+    return graph;
+}
+
+// ============================================================================
+// GraphRuntime
+// ============================================================================
+
+GraphRuntime::GraphRuntime(std::shared_ptr<Graph> graph, std::shared_ptr<GraphTopology> topology)
+    : graph_(std::move(graph)), topology_(std::move(topology)) {}
+
+std::shared_ptr<GraphRuntime> GraphRuntime::for_graph(void* graph_handle) {
+    auto* graph_ptr = get_handle<std::shared_ptr<Graph>>(graph_handle);
+    if (!graph_ptr || !*graph_ptr) {
+        return nullptr;
+    }
+
+    auto* handle =
+        dynamic_cast<GraphHandle*>(HandleRegistry::instance().get_handle_base(graph_handle));
+    if (!handle) {
+        return std::make_shared<GraphRuntime>(*graph_ptr, nullptr);
+    }
+
+    std::lock_guard<std::mutex> lock(handle->runtime_mutex);
+    if (!handle->runtime) {
+        handle->runtime = std::make_shared<GraphRuntime>(*graph_ptr, handle->topology);
+    }
+    return handle->runtime;
+}
+
+std::shared_ptr<const ExecutionPlan> GraphRuntime::plan() {
+    auto snapshot = topology_ ? topology_->snapshot(*graph_) : build_snapshot(*graph_, 0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (plan_ && plan_->snapshot == snapshot) {
+        return plan_;
+    }
+
+    plan_ = compile_plan(std::move(snapshot));
+    folded_.clear();
+    ++generation_; // Workers checked out now are dropped on release, their node may be gone
+
+    // Idle workers and measured costs stay valid for the nodes that are still there: a
+    // topology change leaves a node's configuration, which its workers copied, alone
+    std::unordered_map<const Node*, std::vector<Worker>> idle_workers;
+    std::unordered_map<const Node*, uint64_t> costs;
+    for (const auto& node : plan_->snapshot->nodes) {
+        auto workers = idle_workers_.find(node.get());
+        if (workers != idle_workers_.end()) {
+            for (auto& worker : workers->second) {
+                worker.generation = generation_;
+            }
+            idle_workers.emplace(node.get(), std::move(workers->second));
+        }
+        auto it = costs_.find(node.get());
+        if (it != costs_.end()) {
+            costs.emplace(*it);
+        }
+    }
+    idle_workers_ = std::move(idle_workers);
+    costs_ = std::move(costs);
+    return plan_;
+}
+
+FlowError GraphRuntime::evaluate(const std::string& node_id, const std::string& port_key,
+                                 SharedNodeData& data) {
+    data = nullptr;
+    auto current = plan();
+    if (!current->acyclic) {
+        ErrorManager::instance().set_error(FLOW_ERROR_COMPUTATION_FAILED,
+                                           "Graph contains a cycle");
+        return FLOW_ERROR_COMPUTATION_FAILED;
+    }
+
+    const auto& snapshot = *current->snapshot;
+    auto target = snapshot.node_index.find(node_id);
+    if (target == snapshot.node_index.end()) {
+        ErrorManager::instance().set_error(FLOW_ERROR_NODE_NOT_FOUND,
+                                           "Node not found with ID: " + node_id);
+        return FLOW_ERROR_NODE_NOT_FOUND;
+    }
+
+    const std::size_t last_step = current->step_of[target->second];
+    const auto& ports = current->steps[last_step].output_ports;
+    if (!std::binary_search(ports.begin(), ports.end(), port_key)) {
+        ErrorManager::instance().set_error(FLOW_ERROR_PORT_NOT_FOUND,
+                                           "Output port not found: " + port_key);
+        return FLOW_ERROR_PORT_NOT_FOUND;
+    }
+
+    std::vector<bool> in_cone(snapshot.nodes.size(), false);
+    std::vector<std::size_t> pending{target->second};
+    in_cone[target->second] = true;
+    while (!pending.empty()) {
+        std::size_t index = pending.back();
+        pending.pop_back();
+        for (std::size_t source : snapshot.upstream[index]) {
+            if (!in_cone[source]) {
+                in_cone[source] = true;
+                pending.push_back(source);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (cache_plan_ != current) {
+        cache_.clear();
+        cache_plan_ = current;
+    }
+
+    // The whole cone precedes the target in topological order
+    std::vector<PortValues> values(snapshot.nodes.size());
+    std::vector<const PortValues*> outputs(snapshot.nodes.size(), nullptr);
+    for (std::size_t i = 0; i <= last_step; ++i) {
+        const auto& step = current->steps[i];
+        if (!in_cone[step.node]) {
+            continue;
+        }
+
+        const auto& node = snapshot.nodes[step.node];
+        const auto& id = snapshot.node_ids[step.node];
+        PortValues inputs;
+        if (!gather_inputs(snapshot, step, nullptr, outputs, inputs)) {
+            cache_.erase(id);
+            continue;
+        }
+
+        // Same values (compared by identity) in, so the same values out
+        auto cached = cache_.find(id);
+        if (cached != cache_.end() && cached->second.inputs == inputs) {
+            values[step.node] = cached->second.outputs;
+            outputs[step.node] = &values[step.node];
+            continue;
+        }
+
+        std::string error;
+        FlowError result = compute(node, step, inputs, values[step.node], error);
+        if (result != FLOW_SUCCESS) {
+            cache_.erase(id);
+            ErrorManager::instance().set_error(
+                result, "Node '" + node->GetName() + "' failed: " + error);
+            return result;
+        }
+        cache_[id] = CachedNode{std::move(inputs), values[step.node]};
+        outputs[step.node] = &values[step.node];
+    }
+
+    if (const PortValues* target_outputs = outputs[target->second]) {
+        auto value = target_outputs->find(port_key);
+        if (value != target_outputs->end()) {
+            data = value->second;
+        }
+    }
+    return FLOW_SUCCESS;
+}
+
+void GraphRuntime::clear_cache() {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    cache_.clear();
+    cache_plan_.reset();
+}
+
+bool GraphRuntime::find_folded(const std::string& node_id, const PortValues& inputs,
+                               PortValues& outputs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = folded_.find(node_id);
+    if (it == folded_.end() || it->second.inputs != inputs) {
+        return false;
+    }
+    outputs = it->second.outputs;
+    return true;
+}
+
+void GraphRuntime::store_folded(const std::string& node_id, PortValues inputs,
+                                PortValues outputs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    folded_[node_id] = CachedNode{std::move(inputs), std::move(outputs)};
+}
+
+bool GraphRuntime::release_node_state() {
+    // Not waited for: an evaluation computes under cache_mutex_ and may take any time
+    std::unique_lock<std::mutex> cache_lock(cache_mutex_, std::try_to_lock);
+    if (cache_lock) {
+        cache_.clear();
+        cache_plan_.reset();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    plan_.reset();
+    tasks_.reset();
+    tasks_plan_.reset();
+    idle_workers_.clear();
+    folded_.clear();
+    costs_.clear();
+    ++generation_; // Workers still checked out are dropped when they come back
+    return cache_lock.owns_lock() && busy_workers_ == 0;
+}
+
+void GraphRuntime::set_sink(const std::string& node_id, const std::string& port_key,
+                            bool is_sink) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_sink) {
+        sinks_.emplace(node_id, port_key);
+    } else {
+        sinks_.erase({node_id, port_key});
+    }
+}
+
+std::vector<char> GraphRuntime::live_nodes(const ExecutionPlan& plan) {
+    const auto& snapshot = *plan.snapshot;
+    std::vector<char> live(snapshot.nodes.size(), false);
+    std::vector<std::size_t> pending;
+    auto mark = [&](const std::string& node_id) {
+        auto it = snapshot.node_index.find(node_id);
+        if (it != snapshot.node_index.end() && !live[it->second]) {
+            live[it->second] = true;
+            pending.push_back(it->second);
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [node_id, port_key] : sinks_) {
+            mark(node_id);
+        }
+        if (bindings_) {
+            for (const auto& binding : bindings_->outputs) {
+                mark(binding.node_id);
+            }
+        }
+    }
+
+    while (!pending.empty()) {
+        std::size_t index = pending.back();
+        pending.pop_back();
+        for (std::size_t source : snapshot.upstream[index]) {
+            if (!live[source]) {
+                live[source] = true;
+                pending.push_back(source);
+            }
+        }
+    }
+    return live;
+}
+
+void GraphRuntime::set_output_cache(std::shared_ptr<OutputCache> cache,
+                                    uint64_t min_compute_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    output_cache_ = std::move(cache);
+    cache_min_cost_ns_ = min_compute_ns;
+}
+
+void GraphRuntime::set_fusion_threshold(uint64_t max_task_cost_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fusion_threshold_ns_ = max_task_cost_ns;
+}
+
+std::shared_ptr<const TaskGraph>
+GraphRuntime::tasks(const std::shared_ptr<const ExecutionPlan>& plan) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_ && tasks_plan_ == plan && tasks_threshold_ns_ == fusion_threshold_ns_ &&
+        tasks_measured_ == costs_.size()) {
+        return tasks_;
+    }
+
+    // Rebuilt when a node is measured for the first time, so chains split once their
+    // real cost is known
+    auto cost = [&](std::size_t node) {
+        auto it = costs_.find(plan->snapshot->nodes[node].get());
+        return it != costs_.end() ? it->second : uint64_t{0};
+    };
+    tasks_ = std::make_shared<const TaskGraph>(build_task_graph(*plan, cost, fusion_threshold_ns_));
+    tasks_plan_ = plan;
+    tasks_threshold_ns_ = fusion_threshold_ns_;
+    tasks_measured_ = costs_.size();
+    return tasks_;
+}
+
+void GraphRuntime::set_bindings(std::shared_ptr<const GraphBindings> bindings) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bindings_ = std::move(bindings);
+}
+
+std::shared_ptr<const GraphBindings> GraphRuntime::bindings() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bindings_;
+}
+
+void GraphRuntime::warm(std::size_t copies) {
+    auto current = plan();
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = generation_;
+    }
+
+    for (const auto& step : current->steps) {
+        const auto& node = current->snapshot->nodes[step.node];
+        std::size_t idle = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle = idle_workers_[node.get()].size();
+        }
+        for (; idle < copies; ++idle) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++busy_workers_;
+            }
+            Worker worker = create_worker(node, generation);
+            const bool created = static_cast<bool>(worker.node);
+            release_worker(node, std::move(worker), 0);
+            if (!created) {
+                break; // Reported when the node is computed
+            }
+        }
+    }
+}
+
+GraphRuntime::Worker GraphRuntime::create_worker(const SharedNode& node, uint64_t generation) {
+    auto env = node->GetEnv();
+    auto factory = env ? env->GetFactory() : nullptr;
+    if (!factory) {
+        return {};
+    }
+
+    auto copy = factory->CreateNode(node->GetClass(), node->ID(), node->GetName(), env);
+    if (!copy && resolve_lazy_node_class(factory, node->GetClass())) {
+        copy = factory->CreateNode(node->GetClass(), node->ID(), node->GetName(), env);
+    }
+    if (!copy) {
+        return {};
+    }
+
+    try {
+        copy->Restore(node->Save());
+    } catch (const std::exception&) {
+        // Keep the class defaults
+    }
+
+    auto error = std::make_shared<std::string>();
+    copy->OnError.Bind("flow_ffi_executor",
+                       [error](const std::exception& e) { *error = e.what(); });
+    return {std::move(copy), std::move(error), generation};
+}
+
+GraphRuntime::Worker GraphRuntime::acquire_worker(const SharedNode& node) {
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = generation_;
+        ++busy_workers_;
+        auto it = idle_workers_.find(node.get());
+        if (it != idle_workers_.end() && !it->second.empty()) {
+            Worker worker = std::move(it->second.back());
+            it->second.pop_back();
+            return worker;
+        }
+    }
+    return create_worker(node, generation);
+}
+
+void GraphRuntime::release_worker(const SharedNode& node, Worker worker, uint64_t cost_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --busy_workers_;
+    if (!worker.node || worker.generation != generation_) {
+        // Destroyed before release_node_state can see the worker is no longer busy
+        worker = {};
+        return;
+    }
+
+    // Moving average, so one slow call does not split a chain for good. Zero means the
+    // worker did not compute (warm-up).
+    if (cost_ns > 0) {
+        auto [cost, inserted] = costs_.emplace(node.get(), cost_ns);
+        if (!inserted) {
+            cost->second = (cost->second * 7 + cost_ns) / 8;
+        }
+    }
+    idle_workers_[node.get()].push_back(std::move(worker));
+}
+
+FlowError GraphRuntime::compute(const SharedNode& node, const ExecutionPlan::Step& step,
+                                const PortValues& inputs, PortValues& outputs,
+                                std::string& error, bool* from_cache) {
+    // Nodes measured cheaper than the threshold compute faster than a disk lookup
+    std::shared_ptr<OutputCache> cache;
+    uint64_t min_cost_ns = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cost = costs_.find(node.get());
+        if (output_cache_ && (cost == costs_.end() || cost->second >= cache_min_cost_ns_)) {
+            cache = output_cache_;
+            min_cost_ns = cache_min_cost_ns_;
+        }
+    }
+    OutputCache::Key key;
+    if (cache && !OutputCache::make_key(*node, inputs, key)) {
+        cache.reset();
+    }
+    if (cache && cache->find(key, outputs)) {
+        if (from_cache) {
+            *from_cache = true;
+        }
+        return FLOW_SUCCESS;
+    }
+
+    Worker worker = acquire_worker(node);
+    if (!worker.node) {
+        release_worker(node, std::move(worker), 0);
+        error = "Failed to create a worker for class " + node->GetClass();
+        return FLOW_ERROR_NODE_NOT_FOUND;
+    }
+
+    FlowError result = FLOW_SUCCESS;
+    uint64_t cost_ns = 0;
+    try {
+        for (const auto& [port, data] : inputs) {
+            worker.node->SetInputData(IndexableName(port), data, false);
+        }
+        worker.error->clear();
+        const auto start = std::chrono::steady_clock::now();
+        worker.node->InvokeCompute();
+        cost_ns = elapsed_ns(start);
+
+        if (!worker.error->empty()) {
+            error = *worker.error;
+            result = FLOW_ERROR_COMPUTATION_FAILED;
+        } else {
+            for (const auto& port : step.output_ports) {
+                const SharedNodeData& data = worker.node->GetOutputData(IndexableName(port));
+                if (data) {
+                    outputs[port] = data;
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        error = e.what();
+        result = FLOW_ERROR_COMPUTATION_FAILED;
+    }
+
+    // Pooled workers hold no values
+    try {
+        for (const auto& port : step.input_ports) {
+            worker.node->SetInputData(IndexableName(port), nullptr, false);
+        }
+        for (const auto& port : step.output_ports) {
+            worker.node->SetOutputData(IndexableName(port), nullptr, false);
+        }
+    } catch (const std::exception&) {
+        worker.node.reset(); // Not reusable
+    }
+    release_worker(node, std::move(worker), cost_ns);
+
+    if (cache && result == FLOW_SUCCESS && cost_ns >= min_cost_ns) {
+        cache->store(key, outputs);
+    }
+    return result;
+}
+
+// ============================================================================
+// ExecutionContext
+// ============================================================================
+
+ExecutionContext::ExecutionContext(std::shared_ptr<GraphRuntime> runtime, bool pool_owned)
+    : runtime_(std::move(runtime)), pool_owned_(pool_owned) {}
+
+FlowError ExecutionContext::set_input(const std::string& node_id, const std::string& port_key,
+                                      SharedNodeData data) {
+    auto plan = runtime_->plan();
+    auto it = plan->snapshot->node_index.find(node_id);
+    if (it == plan->snapshot->node_index.end()) {
+        ErrorManager::instance().set_error(FLOW_ERROR_NODE_NOT_FOUND,
+                                           "Node not found with ID: " + node_id);
+        return FLOW_ERROR_NODE_NOT_FOUND;
+    }
+
+    const auto& ports = plan->snapshot->nodes[it->second]->GetInputPorts();
+    if (ports.find(IndexableName(port_key)) == ports.end()) {
+        ErrorManager::instance().set_error(FLOW_ERROR_PORT_NOT_FOUND,
+                                           "Input port not found: " + port_key);
+        return FLOW_ERROR_PORT_NOT_FOUND;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (data) {
+        inputs_[{node_id, port_key}] = std::move(data);
+    } else {
+        inputs_.erase({node_id, port_key});
+    }
+    return FLOW_SUCCESS;
+}
+
+// State of one run, shared with the helper threads of a parallel run
+struct ExecutionContext::RunState {
+    std::shared_ptr<GraphRuntime> runtime;
+    std::shared_ptr<const ExecutionPlan> plan;
+    const InputOverrides* inputs = nullptr; // The context's, or inputs_copy
+    InputOverrides inputs_copy;             // For runs that may be abandoned
+    bool constant_folding = false;
+    std::vector<char> live;                 // By node index; empty when every node runs
+    std::vector<PortValues> values;         // By node index
+    std::vector<const PortValues*> outputs; // By node index; null until produced
+    std::vector<char> folded;               // By node index
+    std::vector<char> settled; // By node index; if set, only these outputs are final
+};
+
+FlowError ExecutionContext::run() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto start = std::chrono::steady_clock::now();
+    FlowRunStats stats{};
+
+    // Shared with helper threads that may outlive an abandoned run
+    auto shared_state = std::make_shared<RunState>();
+    RunState& state = *shared_state;
+    state.runtime = runtime_;
+    state.plan = state.runtime->plan();
+    state.constant_folding = constant_folding_;
+    const bool watched = node_timeout_ms_ > 0 || run_timeout_ms_ > 0;
+    if (watched) {
+        state.inputs_copy = inputs_;
+        state.inputs = &state.inputs_copy;
+    } else {
+        state.inputs = &inputs_;
+    }
+
+    FlowError result = FLOW_SUCCESS;
+    std::string error;
+    if (!state.plan->acyclic) {
+        result = FLOW_ERROR_COMPUTATION_FAILED;
+        error = "Graph contains a cycle";
+    } else {
+        const std::size_t node_count = state.plan->snapshot->nodes.size();
+        state.values.resize(node_count);
+        state.outputs.assign(node_count, nullptr);
+        state.folded.assign(node_count, false);
+        if (eliminate_dead_nodes_) {
+            state.live = state.runtime->live_nodes(*state.plan);
+        }
+
+        if (watched || (parallelism_ > 1 && state.plan->steps.size() > 1)) {
+            result = run_parallel(shared_state, start, stats, error);
+        } else {
+            for (const auto& step : state.plan->steps) {
+                result = run_step(state, step, stats, error);
+                if (result != FLOW_SUCCESS) {
+                    break;
+                }
+            }
+        }
+    }
+
+    // On failure the outputs computed before it stay readable. After a timeout, helpers
+    // still running may read them as inputs, so they are copied rather than moved.
+    outputs_.clear();
+    const auto& node_ids = state.plan->snapshot->node_ids;
+    for (std::size_t i = 0; i < state.outputs.size(); ++i) {
+        if (state.settled.empty()) {
+            if (state.outputs[i]) {
+                outputs_.emplace(node_ids[i], std::move(state.values[i]));
+            }
+        } else if (state.settled[i] && state.outputs[i]) {
+            outputs_.emplace(node_ids[i], state.values[i]);
+        }
+    }
+
+    stats.duration_ns = elapsed_ns(start);
+    stats_ = stats;
+    if (result != FLOW_SUCCESS) {
+        ErrorManager::instance().set_error(result, error);
+    }
+    return result;
+}
+
+FlowError ExecutionContext::run_step(RunState& state, const ExecutionPlan::Step& step,
+                                     FlowRunStats& stats, std::string& error) {
+    const auto& snapshot = *state.plan->snapshot;
+    const auto& node = snapshot.nodes[step.node];
+    const auto& id = snapshot.node_ids[step.node];
+
+    if (!state.live.empty() && !state.live[step.node]) {
+        ++stats.nodes_skipped_dead;
+        return FLOW_SUCCESS;
+    }
+
+    PortValues inputs;
+    if (!gather_inputs(snapshot, step, state.inputs, state.outputs, inputs)) {
+        ++stats.nodes_not_ready;
+        return FLOW_SUCCESS;
+    }
+
+    // Constant for this run unless the context sets one of its inputs or one of its
+    // sources was not folded
+    PortValues& node_outputs = state.values[step.node];
+    bool fold = state.constant_folding && step.constant;
+    if (fold) {
+        auto set = state.inputs->lower_bound({id, std::string()});
+        fold = (set == state.inputs->end() || set->first.first != id) &&
+               std::all_of(step.inputs.begin(), step.inputs.end(),
+                           [&](const auto& in) { return state.folded[in.source]; });
+    }
+    if (fold && state.runtime->find_folded(id, inputs, node_outputs)) {
+        state.folded[step.node] = true;
+        state.outputs[step.node] = &node_outputs;
+        ++stats.nodes_folded;
+        return FLOW_SUCCESS;
+    }
+
+    bool from_cache = false;
+    FlowError result =
+        state.runtime->compute(node, step, inputs, node_outputs, error, &from_cache);
+    if (result != FLOW_SUCCESS) {
+        error = "Node '" + node->GetName() + "' failed: " + error;
+        return result;
+    }
+    ++(from_cache ? stats.nodes_cached : stats.nodes_computed);
+    if (fold) {
+        state.folded[step.node] = true;
+        state.runtime->store_folded(id, std::move(inputs), node_outputs);
+    }
+    state.outputs[step.node] = &node_outputs;
+    return FLOW_SUCCESS;
+}
+
+FlowError ExecutionContext::run_parallel(const std::shared_ptr<RunState>& state,
+                                         std::chrono::steady_clock::time_point start,
+                                         FlowRunStats& stats, std::string& error) {
+    using Clock = std::chrono::steady_clock;
+
+    struct Schedule {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<std::size_t> ready;       // A heap under critical-path scheduling
+        std::vector<std::size_t> waiting_on; // By task, unfinished dependencies
+        std::vector<char> done;              // By task
+        std::unordered_map<std::size_t, Clock::time_point> computing; // By node, if watched
+        std::size_t finished = 0;
+        std::size_t running = 0;
+        std::atomic<bool> stopped{false}; // Set with failure, checked between steps
+        FlowError failure = FLOW_SUCCESS;
+        std::string message;
+        FlowRunStats stats{};
+    };
+
+    auto tasks = state->runtime->tasks(state->plan);
+    const std::size_t task_count = tasks->tasks.size();
+    if (task_count == 0) {
+        return FLOW_SUCCESS;
+    }
+
+    auto schedule = std::make_shared<Schedule>();
+    schedule->waiting_on.reserve(task_count);
+    for (const auto& task : tasks->tasks) {
+        schedule->waiting_on.push_back(task.dependencies);
+    }
+    schedule->done.assign(task_count, false);
+    schedule->ready.assign(tasks->roots.begin(), tasks->roots.end());
+
+    // Under critical-path scheduling the ready task heading the longest remaining path
+    // runs first, ties going to the task created first
+    const bool critical_path = policy_ == FLOW_SCHEDULE_CRITICAL_PATH;
+    auto runs_later = [tasks](std::size_t a, std::size_t b) {
+        uint64_t path_a = tasks->tasks[a].critical_path_ns;
+        uint64_t path_b = tasks->tasks[b].critical_path_ns;
+        return path_a != path_b ? path_a < path_b : a > b;
+    };
+    if (critical_path) {
+        std::make_heap(schedule->ready.begin(), schedule->ready.end(), runs_later);
+    }
+
+    // Holds only shared state, so a helper stuck in a node may outlive the run. Helpers
+    // that start after the run is over return without touching it.
+    const bool watched = node_timeout_ms_ > 0 || run_timeout_ms_ > 0;
+    auto drain = [schedule, tasks, state, task_count, critical_path, runs_later, watched] {
+        std::unique_lock<std::mutex> lock(schedule->mutex);
+        while (true) {
+            schedule->changed.wait(lock, [&] {
+                return !schedule->ready.empty() || schedule->finished == task_count ||
+                       schedule->failure != FLOW_SUCCESS;
+            });
+            if (schedule->ready.empty() || schedule->failure != FLOW_SUCCESS) {
+                return;
+            }
+            std::size_t index;
+            if (critical_path) {
+                std::pop_heap(schedule->ready.begin(), schedule->ready.end(), runs_later);
+                index = schedule->ready.back();
+                schedule->ready.pop_back();
+            } else {
+                index = schedule->ready.front();
+                schedule->ready.pop_front();
+            }
+            ++schedule->running;
+            lock.unlock();
+
+            // A fused chain runs back to back on this thread
+            const auto& task = tasks->tasks[index];
+            FlowRunStats task_stats{};
+            std::string task_error;
+            FlowError result = FLOW_SUCCESS;
+            for (std::size_t step : task.steps) {
+                if (schedule->stopped.load(std::memory_order_relaxed)) {
+                    break;
+                }
+                const auto& plan_step = state->plan->steps[step];
+                if (watched) {
+                    std::lock_guard<std::mutex> guard(schedule->mutex);
+                    schedule->computing[plan_step.node] = Clock::now();
+                    schedule->changed.notify_all(); // New deadline for the watchdog
+                }
+                result = run_step(*state, plan_step, task_stats, task_error);
+                if (watched) {
+                    std::lock_guard<std::mutex> guard(schedule->mutex);
+                    schedule->computing.erase(plan_step.node);
+                }
+                if (result != FLOW_SUCCESS) {
+                    break;
+                }
+            }
+
+            lock.lock();
+            --schedule->running;
+            ++schedule->finished;
+            schedule->done[index] = true;
+            ++schedule->stats.tasks_scheduled;
+            schedule->stats.nodes_computed += task_stats.nodes_computed;
+            schedule->stats.nodes_skipped_dead += task_stats.nodes_skipped_dead;
+            schedule->stats.nodes_not_ready += task_stats.nodes_not_ready;
+            schedule->stats.nodes_folded += task_stats.nodes_folded;
+            schedule->stats.nodes_cached += task_stats.nodes_cached;
+            if (result != FLOW_SUCCESS) {
+                if (schedule->failure == FLOW_SUCCESS) {
+                    schedule->failure = result;
+                    schedule->message = std::move(task_error);
+                    schedule->stopped = true;
+                }
+            } else {
+                for (std::size_t next : task.next) {
+                    if (--schedule->waiting_on[next] == 0) {
+                        schedule->ready.push_back(next);
+                        if (critical_path) {
+                            std::push_heap(schedule->ready.begin(), schedule->ready.end(),
+                                           runs_later);
+                        }
+                    }
+                }
+            }
+            schedule->changed.notify_all();
+        }
+    };
+
+    // A watched run leaves the calling thread free to act as the watchdog
+    const std::size_t threads = std::min(parallelism_, task_count);
+    const std::size_t helpers = watched ? threads : threads - 1;
+    for (std::size_t i = 0; i < helpers; ++i) {
+        HelperThreads::instance().submit(drain);
+    }
+
+    if (!watched) {
+        drain();
+        std::unique_lock<std::mutex> lock(schedule->mutex);
+        schedule->changed.wait(lock, [&] { return schedule->running == 0; });
+        stats = schedule->stats;
+        error = std::move(schedule->message);
+        return schedule->failure;
+    }
+
+    // Watchdog: wakes for each task finished or node started, and at the nearest deadline
+    const auto node_budget = std::chrono::milliseconds(node_timeout_ms_);
+    const auto run_deadline = start + std::chrono::milliseconds(run_timeout_ms_);
+    std::vector<std::size_t> timed_out; // Nodes
+    std::string timeout_message;
+    std::unique_lock<std::mutex> lock(schedule->mutex);
+    while (schedule->running > 0 ||
+           (schedule->failure == FLOW_SUCCESS && schedule->finished < task_count)) {
+        const auto now = Clock::now();
+        bool has_deadline = run_timeout_ms_ > 0;
+        auto deadline = run_deadline;
+        if (node_timeout_ms_ > 0) {
+            for (const auto& [node, since] : schedule->computing) {
+                if (since + node_budget <= now) {
+                    timed_out.push_back(node);
+                } else if (!has_deadline || since + node_budget < deadline) {
+                    deadline = since + node_budget;
+                    has_deadline = true;
+                }
+            }
+        }
+
+        if (!timed_out.empty()) {
+            const auto& name = state->plan->snapshot->nodes[timed_out.front()]->GetName();
+            timeout_message = "Node '" + name + "' timed out after " +
+                              std::to_string(node_timeout_ms_) + " ms";
+        } else if (run_timeout_ms_ > 0 && now >= run_deadline) {
+            // Whatever is still computing is what ran out the budget
+            for (const auto& [node, since] : schedule->computing) {
+                timed_out.push_back(node);
+            }
+            timeout_message = "Run timed out after " + std::to_string(run_timeout_ms_) + " ms";
+        } else if (has_deadline) {
+            schedule->changed.wait_until(lock, deadline);
+            continue;
+        } else {
+            schedule->changed.wait(lock);
+            continue;
+        }
+
+        // Cancel everything not started yet; an earlier node failure stays the reported one
+        if (schedule->failure == FLOW_SUCCESS) {
+            schedule->failure = FLOW_ERROR_TIMEOUT;
+            schedule->message = timeout_message;
+        }
+        schedule->stopped = true;
+        schedule->changed.notify_all();
+        break;
+    }
+
+    // Tasks still computing are abandoned: only the outputs of finished tasks are kept, and
+    // each thread they hold is replaced until they return
+    if (schedule->running > 0) {
+        state->settled.assign(state->outputs.size(), false);
+        for (std::size_t t = 0; t < task_count; ++t) {
+            if (schedule->done[t]) {
+                for (std::size_t step : tasks->tasks[t].steps) {
+                    state->settled[state->plan->steps[step].node] = true;
+                }
+            }
+        }
+        for (std::size_t i = 0; i < schedule->running; ++i) {
+            HelperThreads::instance().replace_stuck_thread();
+        }
+    }
+    stats = schedule->stats;
+    error = schedule->message;
+    FlowError result = schedule->failure;
+    lock.unlock();
+
+    for (std::size_t node : timed_out) {
+        state->plan->snapshot->nodes[node]->OnError.Broadcast(
+            std::runtime_error(timeout_message));
+    }
+    return result;
+}
+
+void ExecutionContext::set_timeouts(uint64_t node_timeout_ms, uint64_t run_timeout_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    node_timeout_ms_ = node_timeout_ms;
+    run_timeout_ms_ = run_timeout_ms;
+}
+
+void ExecutionContext::set_eliminate_dead_nodes(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    eliminate_dead_nodes_ = enabled;
+}
+
+void ExecutionContext::set_parallelism(std::size_t max_threads) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    parallelism_ = max_threads > 0 ? max_threads
+                                   : std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ExecutionContext::set_scheduling_policy(FlowSchedulingPolicy policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
+}
+
+void ExecutionContext::set_constant_folding(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    constant_folding_ = enabled;
+}
+
+FlowRunStats ExecutionContext::last_run_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+SharedNodeData ExecutionContext::get_output(const std::string& node_id,
+                                            const std::string& port_key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto node = outputs_.find(node_id);
+    if (node == outputs_.end()) {
+        return nullptr;
+    }
+    auto port = node->second.find(port_key);
+    return port != node->second.end() ? port->second : nullptr;
+}
+
+void ExecutionContext::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inputs_.clear();
+    outputs_.clear();
+}
+
+bool ExecutionContext::release_outputs() {
+    // A run holds mutex_ throughout
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock) {
+        return false;
+    }
+    outputs_.clear();
+    return true;
+}
+
+// ============================================================================
+// ContextPool
+// ============================================================================
+
+ContextPool::ContextPool(std::shared_ptr<GraphRuntime> runtime, std::size_t size) {
+    runtime->warm(size);
+    handles_.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        auto context = std::make_shared<ExecutionContext>(runtime, true);
+        handles_.push_back(create_handle<std::shared_ptr<ExecutionContext>>(std::move(context)));
+    }
+    idle_ = handles_;
+}
+
+ContextPool::~ContextPool() {
+    // A call still running on a checked out context keeps its context alive
+    for (void* handle : handles_) {
+        release_handle(handle);
+    }
+}
+
+void* ContextPool::acquire(int64_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto has_idle = [this] { return !idle_.empty(); };
+    if (timeout_ms < 0) {
+        available_cv_.wait(lock, has_idle);
+    } else if (!available_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_idle)) {
+        return nullptr;
+    }
+
+    void* handle = idle_.back();
+    idle_.pop_back();
+    return handle;
+}
+
+bool ContextPool::release(void* context_handle) {
+    if (std::find(handles_.begin(), handles_.end(), context_handle) == handles_.end()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::find(idle_.begin(), idle_.end(), context_handle) != idle_.end()) {
+            return false;
+        }
+    }
+
+    // Reset outside the pool lock; only the releasing caller holds the context now
+    auto* context = get_handle<std::shared_ptr<ExecutionContext>>(context_handle);
+    if (context && *context) {
+        (*context)->clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(context_handle);
+    }
+    available_cv_.notify_one();
+    return true;
+}
+
+std::size_t ContextPool::available() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+}
+
+// ============================================================================
+// Module reloads
+// ============================================================================
+
+bool release_executor_state() {
+    // Collected first: the graph handle lookup needs the registry lock for_each_handle holds
+    std::vector<std::shared_ptr<ExecutionContext>> contexts;
+    for_each_handle<std::shared_ptr<ExecutionContext>>(
+        [&contexts](void*, std::shared_ptr<ExecutionContext>& context) {
+            if (context) {
+                contexts.push_back(context);
+            }
+        });
+    std::vector<void*> graph_handles;
+    for_each_handle<std::shared_ptr<Graph>>([&graph_handles](void* handle, std::shared_ptr<Graph>&) {
+        graph_handles.push_back(handle);
+    });
+
+    bool released = true;
+    std::set<std::shared_ptr<GraphRuntime>> runtimes;
+    for (const auto& context : contexts) {
+        released = context->release_outputs() && released;
+        runtimes.insert(context->runtime());
+    }
+    for (void* handle : graph_handles) {
+        auto* graph_handle =
+            dynamic_cast<GraphHandle*>(HandleRegistry::instance().get_handle_base(handle));
+        if (graph_handle) {
+            std::lock_guard<std::mutex> lock(graph_handle->runtime_mutex);
+            if (graph_handle->runtime) {
+                runtimes.insert(graph_handle->runtime);
+            }
+        }
+    }
+
+    for (const auto& runtime : runtimes) {
+        released = runtime->release_node_state() && released;
+    }
+    return released;
+}
+
+bool canonical_node_id(const char* node_id, std::string& canonical) {
+    try {
+        canonical = std::string(UUID(node_id));
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace flow_ffi
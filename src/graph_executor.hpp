@@ -0,0 +1,306 @@
+#pragma once
+
+#include "flow_ffi.h"
+
+#include <flow/core/Graph.hpp>
+#include <flow/core/Node.hpp>
+#include <flow/core/NodeData.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph_snapshot.hpp"
+#include "output_cache.hpp"
+
+namespace flow_ffi {
+
+// Bridge-side execution of a graph with per-run port values.
+//
+// The graph's nodes hold the topology and configuration and are never computed or
+// written to here. Each compute borrows a detached worker copy of the node from a pool
+// shared by all contexts of the graph, feeds it the context's values and hands the
+// outputs back to the context, so concurrent runs only cost their own port values plus
+// one worker per node actually computing at the same time.
+
+using PortValues = std::unordered_map<std::string, flow::SharedNodeData>;
+
+// A snapshot compiled into topological order
+struct ExecutionPlan {
+    struct Input {
+        std::size_t source; // Index into snapshot->nodes
+        std::string source_port;
+        std::string target_port;
+    };
+
+    struct Step {
+        std::size_t node; // Index into snapshot->nodes
+        std::vector<Input> inputs;
+        std::vector<std::string> input_ports;
+        std::vector<std::string> output_ports;
+        bool constant = false; // Has inputs, each unconnected or fed by a constant step
+    };
+
+    SharedGraphSnapshot snapshot;
+    std::vector<Step> steps;          // Topological order, empty if the graph has a cycle
+    std::vector<std::size_t> step_of; // Node index -> index into steps
+    bool acyclic = true;
+};
+
+std::shared_ptr<const ExecutionPlan> compile_plan(SharedGraphSnapshot snapshot);
+
+// Values set by a caller, by node id and input port
+using InputOverrides = std::map<std::pair<std::string, std::string>, flow::SharedNodeData>;
+
+// Fills inputs for one step from overrides (may be null), the outputs computed so far by
+// node id, and the graph node's own input values; false if an input has no value
+bool gather_inputs(const GraphSnapshot& snapshot, const ExecutionPlan::Step& step,
+                   const InputOverrides* overrides, const std::vector<const PortValues*>& outputs,
+                   PortValues& inputs);
+
+// Scheduling units of a parallel run. A chain of nodes, each the only consumer of the
+// previous one, is fused into one task run back to back on one thread while its
+// estimated cost stays within the fusion threshold.
+struct TaskGraph {
+    struct Task {
+        std::vector<std::size_t> steps; // Indexes into plan.steps, in order
+        std::vector<std::size_t> next;  // Tasks waiting on this one
+        std::size_t dependencies = 0;   // Tasks this one waits on
+        uint64_t cost_ns = 0;           // Estimated; unmeasured nodes count as zero
+        uint64_t critical_path_ns = 0;  // Longest path from here to a sink, this task included
+    };
+
+    std::vector<Task> tasks;
+    std::vector<std::size_t> roots;
+};
+
+TaskGraph build_task_graph(const ExecutionPlan& plan,
+                           const std::function<uint64_t(std::size_t)>& node_cost,
+                           uint64_t fusion_threshold_ns);
+
+// Graph-level inputs and outputs declared for flow_graph_invoke, in argument order
+struct PortBinding {
+    std::string node_id; // Canonical
+    std::string port_key;
+};
+
+struct GraphBindings {
+    std::vector<PortBinding> inputs;
+    std::vector<PortBinding> outputs;
+};
+
+// Plan cache, worker pool and bindings shared by every context of one graph
+class GraphRuntime {
+public:
+    GraphRuntime(std::shared_ptr<flow::Graph> graph, std::shared_ptr<GraphTopology> topology);
+
+    // The runtime of a graph handle, created on first use
+    static std::shared_ptr<GraphRuntime> for_graph(void* graph_handle);
+
+    const std::shared_ptr<flow::Graph>& graph() const { return graph_; }
+
+    // Plan for the current topology, recompiled after the graph changed
+    std::shared_ptr<const ExecutionPlan> plan();
+
+    // Computes only the upstream cone of node_id, reusing the outputs of earlier
+    // evaluations whose inputs are unchanged. data is null if the node could not run.
+    FlowError evaluate(const std::string& node_id, const std::string& port_key,
+                       flow::SharedNodeData& data);
+    void clear_cache();
+
+    // Frozen outputs of a constant step, if it was computed from these same input values
+    bool find_folded(const std::string& node_id, const PortValues& inputs, PortValues& outputs);
+    void store_folded(const std::string& node_id, PortValues inputs, PortValues outputs);
+
+    // Observed output ports for dead-node elimination
+    void set_sink(const std::string& node_id, const std::string& port_key, bool is_sink);
+
+    // Per node of plan, whether it feeds an observed port: a sink or an output binding.
+    // Event subscriptions do not count, as context runs compute on worker copies whose
+    // events never reach the graph's nodes.
+    std::vector<char> live_nodes(const ExecutionPlan& plan);
+
+    // Upper bound on the estimated cost of a fused chain; 0 disables fusion
+    void set_fusion_threshold(uint64_t max_task_cost_ns);
+
+    // Tasks of plan under the current threshold and measured node costs
+    std::shared_ptr<const TaskGraph> tasks(const std::shared_ptr<const ExecutionPlan>& plan);
+
+    void set_bindings(std::shared_ptr<const GraphBindings> bindings);
+    std::shared_ptr<const GraphBindings> bindings(); // Null until set
+
+    // Makes sure every node of the current plan has at least copies idle workers
+    void warm(std::size_t copies);
+
+    // Disk cache consulted before and filled after computing a node (null for none).
+    // Nodes measured faster than min_compute_ns skip it.
+    void set_output_cache(std::shared_ptr<OutputCache> cache, uint64_t min_compute_ns);
+
+    // Computes one node of the plan on a worker copy, or loads its outputs from the output
+    // cache, setting from_cache. outputs is filled only on success.
+    FlowError compute(const flow::SharedNode& node, const ExecutionPlan::Step& step,
+                      const PortValues& inputs, PortValues& outputs, std::string& error,
+                      bool* from_cache = nullptr);
+
+    // Drops the plan, idle workers, folded and evaluated outputs, all of which hold objects
+    // built by node classes. false if a worker is still computing or an evaluation is
+    // running, in which case those may outlive the call.
+    bool release_node_state();
+
+private:
+    struct Worker {
+        flow::SharedNode node;
+        std::shared_ptr<std::string> error; // Set by the worker's OnError
+        uint64_t generation = 0;            // Plan the worker belongs to
+    };
+
+    // Outputs of an evaluation, valid while the same input values come in again
+    struct CachedNode {
+        PortValues inputs;
+        PortValues outputs;
+    };
+
+    Worker create_worker(const flow::SharedNode& node, uint64_t generation);
+    Worker acquire_worker(const flow::SharedNode& node);
+    void release_worker(const flow::SharedNode& node, Worker worker, uint64_t cost_ns);
+
+    std::shared_ptr<flow::Graph> graph_;
+    std::shared_ptr<GraphTopology> topology_;
+
+    std::mutex mutex_;
+    std::shared_ptr<const ExecutionPlan> plan_;
+    uint64_t generation_ = 0;
+    std::size_t busy_workers_ = 0; // Checked out or being created
+    std::unordered_map<const flow::Node*, std::vector<Worker>> idle_workers_;
+    std::unordered_map<const flow::Node*, uint64_t> costs_; // Average compute time, ns
+    std::shared_ptr<const GraphBindings> bindings_;
+    std::set<std::pair<std::string, std::string>> sinks_;
+    std::unordered_map<std::string, CachedNode> folded_; // By node id, for the current plan
+
+    uint64_t fusion_threshold_ns_ = 50000;
+    std::shared_ptr<const TaskGraph> tasks_;
+    std::shared_ptr<const ExecutionPlan> tasks_plan_;
+    uint64_t tasks_threshold_ns_ = 0;
+    std::size_t tasks_measured_ = 0;
+
+    std::shared_ptr<OutputCache> output_cache_;
+    uint64_t cache_min_cost_ns_ = 0;
+
+    std::mutex cache_mutex_; // Held for a whole evaluation
+    std::shared_ptr<const ExecutionPlan> cache_plan_;
+    std::unordered_map<std::string, CachedNode> cache_; // By node id
+};
+
+// Per-run state of one graph: the values set by the caller and the outputs of the last
+// run. One context is used by one thread at a time; separate contexts run concurrently.
+class ExecutionContext {
+public:
+    // pool_owned marks a context created by a ContextPool, which only the pool may destroy
+    explicit ExecutionContext(std::shared_ptr<GraphRuntime> runtime, bool pool_owned = false);
+
+    FlowError set_input(const std::string& node_id, const std::string& port_key,
+                        flow::SharedNodeData data);
+
+    FlowError run();
+
+    // Skip nodes that feed no observed port (see GraphRuntime::live_nodes)
+    void set_eliminate_dead_nodes(bool enabled);
+
+    // Reuse the frozen outputs of constant steps not overridden by this context. Off by
+    // default: a node with side effects or hidden state would silently stop computing.
+    void set_constant_folding(bool enabled);
+
+    // Threads a run may use, the calling one included; 0 means one per core
+    void set_parallelism(std::size_t max_threads);
+
+    // Order in which a parallel run starts the tasks that are ready
+    void set_scheduling_policy(FlowSchedulingPolicy policy);
+
+    // Time budgets of one node's compute and of a whole run, 0 for none. With either set,
+    // nodes compute on helper threads while the calling thread watches the budgets.
+    void set_timeouts(uint64_t node_timeout_ms, uint64_t run_timeout_ms);
+
+    FlowRunStats last_run_stats();
+
+    // Null if the node produced nothing on that port in the last run
+    flow::SharedNodeData get_output(const std::string& node_id, const std::string& port_key);
+
+    void clear();
+
+    // Drops the outputs of the last run; false if the context is running
+    bool release_outputs();
+
+    const std::shared_ptr<GraphRuntime>& runtime() const { return runtime_; }
+    bool pool_owned() const { return pool_owned_; }
+
+private:
+    struct RunState;
+
+    static FlowError run_step(RunState& state, const ExecutionPlan::Step& step,
+                              FlowRunStats& stats, std::string& error);
+    FlowError run_parallel(const std::shared_ptr<RunState>& state,
+                           std::chrono::steady_clock::time_point start, FlowRunStats& stats,
+                           std::string& error);
+
+    std::shared_ptr<GraphRuntime> runtime_;
+    const bool pool_owned_;
+
+    std::mutex mutex_;
+    std::size_t parallelism_ = 1;
+    FlowSchedulingPolicy policy_ = FLOW_SCHEDULE_CRITICAL_PATH;
+    uint64_t node_timeout_ms_ = 0;
+    uint64_t run_timeout_ms_ = 0;
+    bool eliminate_dead_nodes_ = false;
+    bool constant_folding_ = false;
+    FlowRunStats stats_{};
+    InputOverrides inputs_;
+    std::unordered_map<std::string, PortValues> outputs_; // By node id
+};
+
+// Fixed set of contexts of one graph, handed out one request at a time. The contexts and
+// one worker per node and context are created up front, so acquiring never builds
+// anything and the memory held stays bounded by the pool size.
+class ContextPool {
+public:
+    ContextPool(std::shared_ptr<GraphRuntime> runtime, std::size_t size);
+    ~ContextPool();
+
+    ContextPool(const ContextPool&) = delete;
+    ContextPool& operator=(const ContextPool&) = delete;
+
+    // Context handle, or null if none became free within timeout_ms (negative waits)
+    void* acquire(int64_t timeout_ms);
+
+    // Clears the context and makes it available again; false if it is not checked out
+    // from this pool
+    bool release(void* context_handle);
+
+    std::size_t size() const { return handles_.size(); }
+    std::size_t available();
+
+private:
+    std::vector<void*> handles_; // Context handles owned by the pool
+
+    std::mutex mutex_;
+    std::condition_variable available_cv_;
+    std::vector<void*> idle_;
+};
+
+// Releases the node state of every graph runtime and the outputs of every context, pooled
+// ones included, so no object built by a module outlives its library across a reload.
+// false if some of it is still in use by a running context or evaluation.
+bool release_executor_state();
+
+// Canonical form of a node id as used in snapshots; false if it is not a UUID
+bool canonical_node_id(const char* node_id, std::string& canonical);
+
+} // namespace flow_ffi
@@ -0,0 +1,218 @@
+#include "graph_snapshot.hpp"
+
+#include <flow/core/Connection.hpp>
+
+#include <algorithm>
+
+using namespace flow;
+
+namespace flow_ffi {
+
+namespace {
+
+void add_unique(std::vector<std::size_t>& indexes, std::size_t index) {
+    if (std::find(indexes.begin(), indexes.end(), index) == indexes.end()) {
+        indexes.push_back(index);
+    }
+}
+
+// The graph's nodes and connections, which never change once created
+struct TopologyCopy {
+    std::vector<SharedNode> nodes;
+    std::vector<SharedConnection> connections;
+};
+
+TopologyCopy copy_topology(const Graph& graph) {
+    TopologyCopy copy;
+    const auto& nodes = graph.GetNodes();
+    copy.nodes.reserve(nodes.size());
+    for (const auto& [uuid, node] : nodes) {
+        if (node) {
+            copy.nodes.push_back(node);
+        }
+    }
+
+    const auto& connections = graph.GetConnections();
+    copy.connections.reserve(connections.Size());
+    for (const auto& [key, connection] : connections) {
+        copy.connections.push_back(connection);
+    }
+    return copy;
+}
+
+SharedGraphSnapshot build_snapshot(TopologyCopy copy, uint64_t version) {
+    auto snapshot = std::make_shared<GraphSnapshot>();
+    snapshot->version = version;
+
+    snapshot->node_ids.reserve(copy.nodes.size());
+    snapshot->node_index.reserve(copy.nodes.size());
+    for (const auto& node : copy.nodes) {
+        std::string id(node->ID());
+        snapshot->node_index.emplace(id, snapshot->node_ids.size());
+        snapshot->node_ids.push_back(std::move(id));
+    }
+    snapshot->nodes = std::move(copy.nodes);
+
+    snapshot->upstream.resize(snapshot->nodes.size());
+    snapshot->downstream.resize(snapshot->nodes.size());
+    snapshot->connections.reserve(copy.connections.size());
+    for (const auto& connection : copy.connections) {
+        ConnectionRecord record{std::string(connection->ID()),
+                                std::string(connection->StartNodeID()),
+                                std::string(connection->StartPortKey()),
+                                std::string(connection->EndNodeID()),
+                                std::string(connection->EndPortKey())};
+
+        auto source = snapshot->node_index.find(record.source_node_id);
+        auto target = snapshot->node_index.find(record.target_node_id);
+        if (source != snapshot->node_index.end() && target != snapshot->node_index.end()) {
+            add_unique(snapshot->downstream[source->second], target->second);
+            add_unique(snapshot->upstream[target->second], source->second);
+        }
+        snapshot->connections.push_back(std::move(record));
+    }
+    return snapshot;
+}
+
+} // namespace
+
+SharedGraphSnapshot build_snapshot(const Graph& graph, uint64_t version) {
+    return build_snapshot(copy_topology(graph), version);
+}
+
+// ============================================================================
+// GraphTopology
+// ============================================================================
+
+SharedGraphSnapshot GraphTopology::load_published() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return published_.load(std::memory_order_acquire);
+#else
+    return std::atomic_load_explicit(&published_, std::memory_order_acquire);
+#endif
+}
+
+void GraphTopology::publish(SharedGraphSnapshot snapshot) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    published_.store(std::move(snapshot), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&published_, std::move(snapshot), std::memory_order_release);
+#endif
+}
+
+void GraphTopology::publish_if_newer(const SharedGraphSnapshot& snapshot) {
+    auto current = load_published();
+    while (!current || current->version < snapshot->version) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        if (published_.compare_exchange_weak(current, snapshot, std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+#else
+        if (std::atomic_compare_exchange_weak_explicit(&published_, &current, snapshot,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_acquire)) {
+#endif
+            return;
+        }
+    }
+}
+
+SharedGraphSnapshot GraphTopology::snapshot(const Graph& graph) {
+    auto current = load_published();
+    if (current && current->version == version()) {
+        return current;
+    }
+
+    // Stale: take the node and connection pointers while no writer can change the graph,
+    // then index them with the lock released, so writers only wait for the copy
+    TopologyCopy copy;
+    uint64_t latest = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(write_mutex_);
+        if (write_depth_ > 0) {
+            // Called back from inside a mutation on this thread: the graph is half changed,
+            // so hand out a private snapshot rather than publishing it
+            return build_snapshot(graph, version());
+        }
+        current = load_published();
+        latest = version();
+        if (current && current->version == latest) {
+            return current;
+        }
+        copy = copy_topology(graph);
+    }
+
+    current = build_snapshot(std::move(copy), latest);
+    publish_if_newer(current); // Unless a concurrent query got a later version out first
+    return current;
+}
+
+// ============================================================================
+// GraphWriteGuard
+// ============================================================================
+
+GraphWriteGuard::GraphWriteGuard(std::shared_ptr<GraphTopology> topology)
+    : topology_(std::move(topology)) {
+    if (topology_) {
+        lock_ = std::unique_lock<std::recursive_mutex>(topology_->write_mutex_);
+        ++topology_->write_depth_;
+    }
+}
+
+GraphWriteGuard::GraphWriteGuard(GraphWriteGuard&& other) noexcept
+    : topology_(std::move(other.topology_)), lock_(std::move(other.lock_)) {}
+
+GraphWriteGuard::~GraphWriteGuard() {
+    // Bumped before the lock is released, so a rebuild under the lock sees a stable version
+    if (topology_) {
+        --topology_->write_depth_;
+        topology_->version_.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+void GraphWriteGuard::discard_snapshot() {
+    if (topology_) {
+        topology_->publish(nullptr);
+    }
+}
+
+// ============================================================================
+// Handles
+// ============================================================================
+
+std::shared_ptr<GraphTopology> get_graph_topology(void* handle) {
+    auto* base = HandleRegistry::instance().get_handle_base(handle);
+    auto* graph_handle = dynamic_cast<GraphHandle*>(base);
+    return graph_handle ? graph_handle->topology : nullptr;
+}
+
+SharedGraphSnapshot graph_snapshot(void* handle, const Graph& graph) {
+    if (auto topology = get_graph_topology(handle)) {
+        return topology->snapshot(graph);
+    }
+    return build_snapshot(graph, 0);
+}
+
+std::vector<GraphWriteGuard> lock_open_graphs() {
+    // Collected first: the topology lookup needs the registry lock for_each_handle holds
+    std::vector<void*> handles;
+    for_each_handle<std::shared_ptr<Graph>>(
+        [&handles](void* handle, std::shared_ptr<Graph>&) { handles.push_back(handle); });
+
+    std::vector<std::shared_ptr<GraphTopology>> topologies;
+    for (void* handle : handles) {
+        if (auto topology = get_graph_topology(handle)) {
+            topologies.push_back(std::move(topology));
+        }
+    }
+    std::sort(topologies.begin(), topologies.end());
+    topologies.erase(std::unique(topologies.begin(), topologies.end()), topologies.end());
+
+    std::vector<GraphWriteGuard> guards;
+    guards.reserve(topologies.size());
+    for (auto& topology : topologies) {
+        guards.emplace_back(std::move(topology));
+    }
+    return guards;
+}
+
+} // namespace flow_ffi
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <flow/core/Graph.hpp>
+#include <flow/core/Node.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "handle_manager.hpp"
+
+namespace flow_ffi {
+
+class GraphRuntime;
+
+// Immutable topology snapshots for concurrent queries (read-copy-update).
+//
+// Writers serialize on the graph's write mutex and bump its version when they finish.
+// The first query after a batch of mutations copies the node and connection pointers
+// under that mutex, builds the snapshot from the copy after releasing it and publishes
+// it; every other query just loads the published snapshot, so readers of an unchanged
+// graph take no lock, writers never wait for a rebuild and a snapshot stays valid for as
+// long as it is held.
+
+struct ConnectionRecord {
+    std::string id;
+    std::string source_node_id;
+    std::string source_port;
+    std::string target_node_id;
+    std::string target_port;
+};
+
+struct GraphSnapshot {
+    uint64_t version = 0;
+    std::vector<flow::SharedNode> nodes;
+    std::vector<std::string> node_ids;
+    std::vector<ConnectionRecord> connections;
+    std::unordered_map<std::string, std::size_t> node_index; // Id -> index into nodes
+
+    // Per node, indexes of the nodes feeding it and fed by it, without duplicates
+    std::vector<std::vector<std::size_t>> upstream;
+    std::vector<std::vector<std::size_t>> downstream;
+};
+
+using SharedGraphSnapshot = std::shared_ptr<const GraphSnapshot>;
+
+SharedGraphSnapshot build_snapshot(const flow::Graph& graph, uint64_t version);
+
+class GraphTopology {
+public:
+    // Latest snapshot of graph, rebuilding it first if a mutation finished since
+    SharedGraphSnapshot snapshot(const flow::Graph& graph);
+
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+private:
+    friend class GraphWriteGuard;
+
+    SharedGraphSnapshot load_published() const;
+    void publish(SharedGraphSnapshot snapshot);
+    void publish_if_newer(const SharedGraphSnapshot& snapshot);
+
+    // Recursive so graph event callbacks running inside a mutation may query or mutate
+    // the same graph again
+    std::recursive_mutex write_mutex_;
+    int write_depth_ = 0; // Guarded by write_mutex_
+    std::atomic<uint64_t> version_{0};
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<SharedGraphSnapshot> published_;
+#else
+    SharedGraphSnapshot published_; // Accessed with std::atomic_load / std::atomic_store
+#endif
+};
+
+// Held for the duration of a topology mutation; the version is bumped on release
+class GraphWriteGuard {
+public:
+    explicit GraphWriteGuard(std::shared_ptr<GraphTopology> topology);
+    ~GraphWriteGuard();
+
+    GraphWriteGuard(GraphWriteGuard&& other) noexcept;
+    GraphWriteGuard(const GraphWriteGuard&) = delete;
+    GraphWriteGuard& operator=(const GraphWriteGuard&) = delete;
+    GraphWriteGuard& operator=(GraphWriteGuard&&) = delete;
+
+    // Drops the published snapshot, so the nodes it holds can be freed during the mutation
+    void discard_snapshot();
+
+private:
+    std::shared_ptr<GraphTopology> topology_;
+    std::unique_lock<std::recursive_mutex> lock_;
+};
+
+// The handle type behind FlowGraphHandle. It is still a Handle<std::shared_ptr<Graph>>,
+// so get_handle<std::shared_ptr<Graph>> keeps working, and carries the topology state.
+class GraphHandle : public Handle<std::shared_ptr<flow::Graph>> {
+public:
+    explicit GraphHandle(std::shared_ptr<flow::Graph> graph)
+        : Handle<std::shared_ptr<flow::Graph>>(std::move(graph)),
+          topology(std::make_shared<GraphTopology>()) {}
+
+    std::shared_ptr<GraphTopology> topology;
+
+    // Execution state of the graph's contexts, pools and bindings, created on first use
+    // (see graph_executor.hpp)
+    std::mutex runtime_mutex;
+    std::shared_ptr<GraphRuntime> runtime;
+};
+
+// Null if handle is not a graph handle
+std::shared_ptr<GraphTopology> get_graph_topology(void* handle);
+
+// Snapshot for a graph handle; built on the spot if the handle has no topology state
+SharedGraphSnapshot graph_snapshot(void* handle, const flow::Graph& graph);
+
+// Write guards for every open graph, taken in a fixed order, for changes that touch
+// many graphs at once such as a module reload
+std::vector<GraphWriteGuard> lock_open_graphs();
+
+} // namespace flow_ffi
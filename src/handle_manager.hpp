@@ -7,6 +7,8 @@
 #include <typeinfo>
 #include <unordered_map>
 
+#include "result_memory.hpp"
+
 namespace flow_ffi {
 
 // Base class for all managed handles
@@ -26,6 +28,10 @@ public:
 
     virtual const char* get_type_name() const = 0;
 
+    // Handles are allocated through the flow_set_allocator hooks
+    static void* operator new(std::size_t size) { return allocate_internal(size); }
+    static void operator delete(void* ptr) noexcept { free_internal(ptr); }
+
 private:
     std::atomic<int32_t> ref_count_;
 };
@@ -79,6 +85,18 @@ public:
         return &handle->get();
     }
 
+    // Visit every handle holding a T. The callback runs under the registry lock and
+    // must not call back into the registry.
+    template <typename T, typename F>
+    void for_each(F&& fn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [ptr, handle] : handles_) {
+            if (auto* typed = dynamic_cast<Handle<T>*>(handle.get())) {
+                fn(ptr, typed->get());
+            }
+        }
+    }
+
     // Get raw handle base (for reference counting)
     HandleBase* get_handle_base(void* ptr) {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -131,6 +149,11 @@ T* get_handle(void* ptr) {
     return HandleRegistry::instance().get_handle<T>(ptr);
 }
 
+template <typename T, typename F>
+void for_each_handle(F&& fn) {
+    HandleRegistry::instance().for_each<T>(std::forward<F>(fn));
+}
+
 inline bool is_valid_handle(void* ptr) {
     return HandleRegistry::instance().is_valid_handle(ptr);
 }
@@ -0,0 +1,337 @@
+#include "memory_usage.hpp"
+
+#include "flow_ffi.h"
+
+#include <flow/core/Node.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "env_wrapper.hpp"
+#include "error_handling.hpp"
+#include "handle_manager.hpp"
+#include "result_memory.hpp"
+#include <nlohmann/json.hpp>
+
+using namespace flow;
+
+namespace flow_ffi {
+
+namespace {
+
+std::size_t string_bytes(const std::string& str) {
+    // Short strings live inside the object itself
+    const char* inline_begin = reinterpret_cast<const char*>(&str);
+    bool is_inline = str.data() >= inline_begin && str.data() < inline_begin + sizeof(str);
+    return is_inline ? 0 : str.capacity() + 1;
+}
+
+struct SizerRegistry {
+    std::shared_mutex mutex;
+    std::map<std::string, NodeDataSizer, std::less<>> sizers;
+
+    SizerRegistry() {
+        sizers.emplace(std::string(TypeName_v<int>),
+                       [](const NodeData&) { return sizeof(detail::NodeData<int>); });
+        sizers.emplace(std::string(TypeName_v<double>),
+                       [](const NodeData&) { return sizeof(detail::NodeData<double>); });
+        sizers.emplace(std::string(TypeName_v<bool>),
+                       [](const NodeData&) { return sizeof(detail::NodeData<bool>); });
+        sizers.emplace(std::string(TypeName_v<std::string>), [](const NodeData& data) {
+            const auto& typed = static_cast<const detail::NodeData<std::string>&>(data);
+            return sizeof(typed) + string_bytes(typed.Get());
+        });
+    }
+};
+
+SizerRegistry& sizer_registry() {
+    static SizerRegistry registry;
+    return registry;
+}
+
+void add_port_data(const SharedPort& port, std::size_t& node_bytes, std::size_t& node_unknown,
+                   GraphMemoryUsage& usage, std::unordered_set<const NodeData*>& seen) {
+    const SharedNodeData& data = port ? port->GetData() : SharedNodeData{};
+    if (!data) {
+        return;
+    }
+
+    auto bytes = node_data_bytes(*data);
+    if (bytes) {
+        node_bytes += *bytes;
+    } else {
+        ++node_unknown;
+    }
+    if (seen.insert(data.get()).second) {
+        ++usage.data_count;
+        if (bytes) {
+            usage.total_bytes += *bytes;
+        } else {
+            ++usage.unknown_count;
+        }
+    }
+}
+
+std::string handle_string(const void* ptr) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%p", ptr);
+    return buffer;
+}
+
+// Graph handles still open, collected before measuring so no registry lock is held
+std::vector<std::pair<void*, std::shared_ptr<Graph>>> open_graphs() {
+    std::vector<std::pair<void*, std::shared_ptr<Graph>>> graphs;
+    for_each_handle<std::shared_ptr<Graph>>([&](void* handle, std::shared_ptr<Graph>& graph) {
+        if (graph) {
+            graphs.emplace_back(handle, graph);
+        }
+    });
+    return graphs;
+}
+
+void sort_nodes(std::vector<NodeMemoryUsage>& nodes, std::size_t top_n) {
+    std::stable_sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) {
+        return a.total_bytes() > b.total_bytes();
+    });
+    if (nodes.size() > top_n) {
+        nodes.resize(top_n);
+    }
+}
+
+nlohmann::json nodes_to_json(const std::vector<NodeMemoryUsage>& nodes) {
+    nlohmann::json result = nlohmann::json::array();
+    for (const auto& node : nodes) {
+        result.push_back({{"id", node.id},
+                          {"name", node.name},
+                          {"class", node.class_name},
+                          {"input_bytes", node.input_bytes},
+                          {"output_bytes", node.output_bytes},
+                          {"total_bytes", node.total_bytes()},
+                          {"unknown_count", node.unknown_count}});
+    }
+    return result;
+}
+
+void fill_usage(FlowMemoryUsage* out, const GraphMemoryUsage& usage, std::size_t graphs) {
+    out->total_bytes = usage.total_bytes;
+    out->data_count = usage.data_count;
+    out->unknown_count = usage.unknown_count;
+    out->node_count = usage.nodes.size();
+    out->graph_count = graphs;
+}
+
+nlohmann::json graph_json(const Graph& graph, GraphMemoryUsage usage, std::size_t top_n) {
+    std::size_t node_count = usage.nodes.size();
+    sort_nodes(usage.nodes, top_n);
+    return {{"name", graph.GetName()},
+            {"total_bytes", usage.total_bytes},
+            {"data_count", usage.data_count},
+            {"unknown_count", usage.unknown_count},
+            {"node_count", node_count},
+            {"nodes", nodes_to_json(usage.nodes)}};
+}
+
+std::string graph_report(const Graph& graph, std::size_t top_n) {
+    std::unordered_set<const NodeData*> seen;
+    return graph_json(graph, measure_graph(graph, seen), top_n).dump(2);
+}
+
+std::string open_graphs_report(std::size_t top_n) {
+    struct GraphEntry {
+        void* handle;
+        std::shared_ptr<Graph> graph;
+        GraphMemoryUsage usage;
+    };
+
+    std::vector<GraphEntry> entries;
+    std::size_t total_bytes = 0;
+    for (auto& [handle, graph] : open_graphs()) {
+        // Each graph is measured on its own so its figure is what releasing it frees
+        std::unordered_set<const NodeData*> seen;
+        auto usage = measure_graph(*graph, seen);
+        total_bytes += usage.total_bytes;
+        entries.push_back({handle, graph, std::move(usage)});
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.usage.total_bytes > b.usage.total_bytes;
+    });
+
+    nlohmann::json graphs = nlohmann::json::array();
+    for (std::size_t i = 0; i < entries.size() && i < top_n; ++i) {
+        auto entry = graph_json(*entries[i].graph, std::move(entries[i].usage), top_n);
+        entry["handle"] = handle_string(entries[i].handle);
+        graphs.push_back(std::move(entry));
+    }
+
+    nlohmann::json report = {{"total_bytes", total_bytes},
+                             {"graph_count", entries.size()},
+                             {"graphs", std::move(graphs)}};
+    return report.dump(2);
+}
+
+} // namespace
+
+void register_node_data_sizer(std::string type_name, NodeDataSizer sizer) {
+    auto& registry = sizer_registry();
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    if (sizer) {
+        registry.sizers[std::move(type_name)] = std::move(sizer);
+    } else {
+        registry.sizers.erase(type_name);
+    }
+}
+
+bool is_builtin_data_type(std::string_view type_name) {
+    return type_name == TypeName_v<int> || type_name == TypeName_v<double> ||
+           type_name == TypeName_v<bool> || type_name == TypeName_v<std::string>;
+}
+
+std::optional<std::size_t> node_data_bytes(const NodeData& data) {
+    auto& registry = sizer_registry();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+    auto it = registry.sizers.find(data.Type());
+    if (it == registry.sizers.end()) {
+        return std::nullopt;
+    }
+    return it->second(data);
+}
+
+GraphMemoryUsage measure_graph(const Graph& graph, std::unordered_set<const NodeData*>& seen) {
+    GraphMemoryUsage usage;
+    usage.nodes.reserve(graph.GetNodes().size());
+
+    for (const auto& [id, node] : graph.GetNodes()) {
+        if (!node) {
+            continue;
+        }
+
+        NodeMemoryUsage node_usage;
+        node_usage.id = std::string(node->ID());
+        node_usage.name = node->GetName();
+        node_usage.class_name = node->GetClass();
+        for (const auto& [key, port] : node->GetInputPorts()) {
+            add_port_data(port, node_usage.input_bytes, node_usage.unknown_count, usage, seen);
+        }
+        for (const auto& [key, port] : node->GetOutputPorts()) {
+            add_port_data(port, node_usage.output_bytes, node_usage.unknown_count, usage, seen);
+        }
+        usage.nodes.push_back(std::move(node_usage));
+    }
+    return usage;
+}
+
+} // namespace flow_ffi
+
+extern "C" {
+
+// ============================================================================
+// Memory Accounting
+// ============================================================================
+
+FLOW_FFI_EXPORT FlowError flow_graph_get_memory_usage(FlowGraphHandle graph,
+                                                      FlowMemoryUsage* usage) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(graph, "graph") ||
+            !flow_ffi::validate_pointer(usage, "usage")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto* graph_ptr = flow_ffi::get_handle<std::shared_ptr<Graph>>(graph);
+        if (!graph_ptr || !*graph_ptr) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Invalid graph handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        std::unordered_set<const NodeData*> seen;
+        flow_ffi::fill_usage(usage, flow_ffi::measure_graph(**graph_ptr, seen), 1);
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT char* flow_graph_get_memory_report(FlowGraphHandle graph, size_t top_n) {
+    FLOW_API_CALL_HANDLE({
+        if (!flow_ffi::validate_handle(graph, "graph")) {
+            return nullptr;
+        }
+
+        auto* graph_ptr = flow_ffi::get_handle<std::shared_ptr<Graph>>(graph);
+        if (!graph_ptr || !*graph_ptr) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Invalid graph handle");
+            return nullptr;
+        }
+
+        return flow_ffi::copy_string(flow_ffi::graph_report(**graph_ptr, top_n));
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_env_get_memory_usage(FlowEnvHandle env, FlowMemoryUsage* usage) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_handle(env, "env") ||
+            !flow_ffi::validate_pointer(usage, "usage")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto* env_wrapper = flow_ffi::get_handle<EnvWrapper>(env);
+        if (!env_wrapper || !env_wrapper->env) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Invalid env handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        // Graphs opened through several handles are measured once
+        std::unordered_set<const Graph*> graphs;
+        std::unordered_set<const NodeData*> seen;
+        flow_ffi::GraphMemoryUsage total;
+        for (const auto& [handle, graph] : flow_ffi::open_graphs()) {
+            if (graph->GetEnv() != env_wrapper->env || !graphs.insert(graph.get()).second) {
+                continue;
+            }
+
+            auto graph_usage = flow_ffi::measure_graph(*graph, seen);
+            total.total_bytes += graph_usage.total_bytes;
+            total.data_count += graph_usage.data_count;
+            total.unknown_count += graph_usage.unknown_count;
+            std::move(graph_usage.nodes.begin(), graph_usage.nodes.end(),
+                      std::back_inserter(total.nodes));
+        }
+
+        flow_ffi::fill_usage(usage, total, graphs.size());
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT FlowError flow_register_data_sizer(const char* type_name,
+                                                   FlowDataSizerFn sizer) {
+    FLOW_API_CALL({
+        if (!flow_ffi::validate_string(type_name, "type_name")) {
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+        if (flow_ffi::is_builtin_data_type(type_name)) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT,
+                std::string("Built-in type is measured by the library: ") + type_name);
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+
+        flow_ffi::NodeDataSizer wrapped;
+        if (sizer) {
+            wrapped = [sizer](const NodeData& data) { return sizer(&data); };
+        }
+        flow_ffi::register_node_data_sizer(type_name, std::move(wrapped));
+        return FLOW_SUCCESS;
+    });
+}
+
+FLOW_FFI_EXPORT char* flow_get_memory_report(size_t top_n) {
+    FLOW_API_CALL_HANDLE({ return flow_ffi::copy_string(flow_ffi::open_graphs_report(top_n)); });
+}
+
+} // extern "C"
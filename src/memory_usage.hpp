@@ -0,0 +1,53 @@
+#pragma once
+
+#include <flow/core/Graph.hpp>
+#include <flow/core/NodeData.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace flow_ffi {
+
+// Byte-size estimates for NodeData values and what graphs hold on to. Sizes cover the
+// NodeData object and the heap storage it owns. Built-in types are measured exactly;
+// other types need a registered sizer and are reported as unknown without one.
+
+using NodeDataSizer = std::function<std::size_t(const flow::NodeData&)>;
+
+// Overrides the estimate for values whose Type() equals type_name; an empty sizer removes it
+void register_node_data_sizer(std::string type_name, NodeDataSizer sizer);
+
+bool is_builtin_data_type(std::string_view type_name);
+
+// Empty if no sizer is registered for the value's type
+std::optional<std::size_t> node_data_bytes(const flow::NodeData& data);
+
+struct NodeMemoryUsage {
+    std::string id;
+    std::string name;
+    std::string class_name;
+    std::size_t input_bytes = 0;
+    std::size_t output_bytes = 0;
+    std::size_t unknown_count = 0; // Values held with no size estimate
+
+    std::size_t total_bytes() const { return input_bytes + output_bytes; }
+};
+
+struct GraphMemoryUsage {
+    std::size_t total_bytes = 0; // Distinct NodeData values, shared values counted once
+    std::size_t data_count = 0;
+    std::size_t unknown_count = 0; // Distinct values with no size estimate, not in total_bytes
+    std::vector<NodeMemoryUsage> nodes;
+};
+
+// Measures a graph; values already in seen are not counted again, so one set can be
+// threaded through several graphs sharing data
+GraphMemoryUsage measure_graph(const flow::Graph& graph,
+                               std::unordered_set<const flow::NodeData*>& seen);
+
+} // namespace flow_ffi
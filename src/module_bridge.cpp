@@ -3,20 +3,706 @@
 
 #include "flow_ffi.h"
 
+#include <flow/core/Connection.hpp>
+#include <flow/core/Env.hpp>
+#include <flow/core/Graph.hpp>
+#include <flow/core/IndexableName.hpp>
 #include <flow/core/Module.hpp>
+#include <flow/core/Node.hpp>
 #include <flow/core/NodeFactory.hpp>
+#include <flow/core/UUID.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "env_wrapper.hpp"
 #include "error_handling.hpp"
+#include "graph_executor.hpp"
+#include "graph_snapshot.hpp"
 #include "handle_manager.hpp"
+#include "module_index.hpp"
+#include "module_stats.hpp"
+#include "module_wrapper.hpp"
+#include "node_wrapper.hpp"
+#include "result_memory.hpp"
+#include "string_interner.hpp"
+#include <nlohmann/json.hpp>
 
 using namespace flow;
 namespace fs = std::filesystem;
 
+namespace {
+
+using ClassSet = std::set<std::pair<std::string, std::string>>;
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Deferred (lazy) modules per factory, consulted when a node class is not registered
+std::mutex g_lazy_mutex;
+std::unordered_map<const NodeFactory*, std::vector<std::weak_ptr<ModuleWrapper>>> g_lazy_modules;
+
+void track_lazy_module(const std::shared_ptr<ModuleWrapper>& wrapper) {
+    std::lock_guard<std::mutex> lock(g_lazy_mutex);
+    g_lazy_modules[wrapper->factory.get()].push_back(wrapper);
+}
+
+std::vector<std::shared_ptr<ModuleWrapper>> lazy_modules_of(const NodeFactory* factory) {
+    std::lock_guard<std::mutex> lock(g_lazy_mutex);
+    std::vector<std::shared_ptr<ModuleWrapper>> modules;
+
+    auto it = g_lazy_modules.find(factory);
+    if (it == g_lazy_modules.end()) {
+        return modules;
+    }
+
+    auto& entries = it->second;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const auto& weak) { return weak.expired(); }),
+                  entries.end());
+    for (const auto& weak : entries) {
+        if (auto wrapper = weak.lock()) {
+            modules.push_back(std::move(wrapper));
+        }
+    }
+    return modules;
+}
+
+// Build of the module that registered each class, by factory and class name
+std::mutex g_build_ids_mutex;
+std::map<std::pair<const NodeFactory*, std::string>, std::string> g_build_ids;
+
+ClassSet registered_classes(const NodeFactory& factory) {
+    ClassSet classes;
+    for (const auto& [category, class_name] : factory.GetCategories()) {
+        classes.emplace(category, class_name);
+    }
+    return classes;
+}
+
+bool is_class_registered(const NodeFactory& factory, const std::string& class_name) {
+    for (const auto& entry : factory.GetCategories()) {
+        if (entry.second == class_name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Registers the module's nodes and records which classes it added.
+// Caller holds the wrapper mutex and the factory registration lock.
+void register_and_record(ModuleWrapper& wrapper) {
+    auto before = registered_classes(*wrapper.factory);
+    auto start = std::chrono::steady_clock::now();
+    wrapper.module->RegisterModuleNodes();
+    wrapper.stats.register_time_ms = elapsed_ms(start);
+    wrapper.registered = true;
+    auto after = registered_classes(*wrapper.factory);
+
+    wrapper.node_classes.clear();
+    for (const auto& [category, class_name] : after) {
+        if (before.find({category, class_name}) == before.end()) {
+            wrapper.node_classes.push_back({category, class_name});
+        }
+    }
+
+    // The library's version, size and modification time, so a rebuilt module does not hit
+    // outputs cached from the previous build
+    std::string build_id;
+    if (const auto& metadata = wrapper.module->GetMetaData()) {
+        build_id = metadata->Version;
+    } else if (wrapper.manifest) {
+        build_id = wrapper.manifest->version;
+    }
+    if (auto fingerprint = flow_ffi::module_fingerprint(wrapper.path)) {
+        build_id += ":" + std::to_string(fingerprint->mtime) + ":" +
+                    std::to_string(fingerprint->size);
+    }
+
+    std::lock_guard<std::mutex> lock(g_build_ids_mutex);
+    for (const auto& entry : wrapper.node_classes) {
+        g_build_ids[{wrapper.factory.get(), entry.class_name}] = build_id;
+    }
+}
+
+// Loads that count the shared objects they map hold this exclusively, other loads hold it
+// shared, so no load maps objects while a counting one compares its snapshots
+std::shared_mutex g_library_load_mutex;
+
+// Loads the shared library and records its timing and the shared objects it mapped.
+// Parallel batches do not count objects, so their loads still overlap each other.
+// Caller holds the wrapper mutex (or owns a wrapper that is not shared yet).
+bool load_library(ModuleWrapper& wrapper, const fs::path& path, bool count_objects = true) {
+    std::unique_lock<std::shared_mutex> counting(g_library_load_mutex, std::defer_lock);
+    std::shared_lock<std::shared_mutex> overlapping(g_library_load_mutex, std::defer_lock);
+    if (count_objects) {
+        counting.lock();
+    } else {
+        overlapping.lock();
+    }
+
+    auto snapshot = count_objects ? flow_ffi::LoadedObjectSnapshot::capture()
+                                  : flow_ffi::LoadedObjectSnapshot{};
+    auto start = std::chrono::steady_clock::now();
+    wrapper.path = path;
+    bool loaded = wrapper.module->Load(path);
+    wrapper.stats.load_time_ms = elapsed_ms(start);
+
+    wrapper.stats.shared_objects = 0;
+    wrapper.stats.dynamic_symbols = 0;
+    if (loaded) {
+        ++wrapper.stats.load_count;
+        if (count_objects) {
+            snapshot.count_new(wrapper.stats.shared_objects, wrapper.stats.dynamic_symbols);
+        }
+    }
+    return loaded;
+}
+
+// Performs the deferred load and registration of a lazy module. Caller holds the
+// wrapper mutex.
+bool materialize(ModuleWrapper& wrapper) {
+    if (wrapper.load_pending) {
+        wrapper.load_pending = false;
+        if (!load_library(wrapper, wrapper.path)) {
+            wrapper.register_pending = false;
+            return false;
+        }
+    }
+
+    if (wrapper.register_pending) {
+        wrapper.register_pending = false;
+        std::lock_guard<std::mutex> lock(
+            flow_ffi::factory_registration_mutex(wrapper.factory.get()));
+        register_and_record(wrapper);
+    }
+    return true;
+}
+
+std::unique_ptr<ModuleManifest> read_manifest(const fs::path& path) {
+    if (!fs::is_directory(path)) {
+        // Packed .fmod archives are only inspected by Module::Load
+        return nullptr;
+    }
+
+    std::vector<fs::path> candidates{path / "module.json"};
+    for (const auto& entry : fs::directory_iterator(path)) {
+        if (entry.is_directory()) {
+            candidates.push_back(entry.path() / "module.json");
+        }
+    }
+
+    for (const auto& candidate : candidates) {
+        std::ifstream file(candidate);
+        if (!file) {
+            continue;
+        }
+
+        auto j = nlohmann::json::parse(file, nullptr, false);
+        if (j.is_discarded() || !j.is_object()) {
+            continue;
+        }
+
+        auto manifest = std::make_unique<ModuleManifest>();
+        manifest->name = j.value("Name", "");
+        manifest->version = j.value("Version", "");
+        manifest->author = j.value("Author", "");
+        manifest->description = j.value("Description", "");
+        return manifest;
+    }
+    return nullptr;
+}
+
+// Records the module path for deferred loading. Caller holds the wrapper mutex.
+void defer_load(const std::shared_ptr<ModuleWrapper>& wrapper, const fs::path& path) {
+    auto start = std::chrono::steady_clock::now();
+    wrapper->path = path;
+    wrapper->manifest = read_manifest(path);
+    wrapper->stats.manifest_time_ms = elapsed_ms(start);
+    wrapper->load_pending = true;
+    track_lazy_module(wrapper);
+}
+
+// Defers a module whose manifest and classes are known from the index.
+// Caller holds the wrapper mutex.
+void defer_from_index(const std::shared_ptr<ModuleWrapper>& wrapper, const fs::path& path,
+                      const flow_ffi::ModuleIndexEntry& entry) {
+    wrapper->path = path;
+    wrapper->manifest = std::make_unique<ModuleManifest>(entry.manifest);
+    wrapper->node_classes = entry.node_classes;
+    wrapper->stats.from_index = true;
+    wrapper->load_pending = true;
+    track_lazy_module(wrapper);
+}
+
+struct PendingModuleLoad {
+    fs::path path;
+    std::shared_ptr<ModuleWrapper> wrapper;
+    std::optional<flow_ffi::ModuleFingerprint> fingerprint;
+    bool indexed = false; // Deferred from a fresh manifest index entry
+    bool loaded = false;
+    FlowError error = FLOW_SUCCESS;
+    std::string error_message;
+    double load_time_ms = 0.0;
+    double register_time_ms = 0.0;
+};
+
+void load_pending_module(PendingModuleLoad& pending, bool count_objects) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        pending.loaded = load_library(*pending.wrapper, pending.path, count_objects);
+        if (!pending.loaded) {
+            pending.error = FLOW_ERROR_MODULE_LOAD_FAILED;
+            pending.error_message = "Failed to load module";
+        }
+    } catch (const std::exception& e) {
+        pending.error = FLOW_ERROR_MODULE_LOAD_FAILED;
+        pending.error_message = e.what();
+    }
+    pending.load_time_ms = elapsed_ms(start);
+}
+
+// Loads (unpacks, parses metadata, dlopens) the modules in parallel. Loading does not
+// touch the factory; registration happens afterwards on the calling thread.
+void load_in_parallel(std::vector<PendingModuleLoad>& pending,
+                      const FlowModuleLoadOptions& opts) {
+    std::size_t thread_count = opts.max_threads > 0
+                                   ? static_cast<std::size_t>(opts.max_threads)
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    thread_count = std::min(thread_count, pending.size());
+
+    std::atomic<std::size_t> next{0};
+    bool count_objects = thread_count == 1;
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < pending.size(); i = next.fetch_add(1)) {
+            if (!pending[i].indexed) {
+                load_pending_module(pending[i], count_objects);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+// State of a node that is re-created across a module reload
+struct MigratedNode {
+    std::shared_ptr<Graph> graph; // Null for nodes that only live in handles
+    std::shared_ptr<Env> env;
+    std::string id;
+    std::string name;
+    std::string class_name;
+    nlohmann::json state;
+    const Node* old_address = nullptr; // Only compared, never dereferenced after release
+    std::weak_ptr<Node> old_node;
+    SharedNode new_node;
+};
+
+struct MigratedConnection {
+    std::shared_ptr<Graph> graph;
+    std::string start_id;
+    std::string start_key;
+    std::string end_id;
+    std::string end_key;
+};
+
+// Handles that point at an affected node, so they can be swapped to the new instance
+struct MigratedHandle {
+    void* handle;
+    bool shared_node; // Handle<std::shared_ptr<Node>> (event bridge) vs Handle<NodeWrapper>
+    const Node* old_address;
+};
+
+// A value computed by an affected node, left on a port of another node in its graph
+struct HeldValue {
+    SharedNode node;
+    IndexableName key;
+    bool input;
+    SharedNodeData data;
+};
+
+struct ReloadPlan {
+    std::vector<MigratedNode> nodes;
+    std::vector<MigratedConnection> connections;
+    std::vector<MigratedHandle> handles;
+    std::vector<std::weak_ptr<NodeData>> values; // Outputs of the planned nodes
+    std::vector<HeldValue> held;                 // Cleared while the library is swapped
+    std::size_t graphs_affected = 0;
+};
+
+void record_outputs(ReloadPlan& plan, const Node& node) {
+    for (const auto& [key, port] : node.GetOutputPorts()) {
+        if (port && port->GetData()) {
+            plan.values.push_back(port->GetData());
+        }
+    }
+}
+
+// Saves every node of the given classes in open graphs and node handles
+ReloadPlan plan_reload(const std::set<std::string>& classes) {
+    ReloadPlan plan;
+
+    std::vector<std::shared_ptr<Graph>> graphs;
+    flow_ffi::for_each_handle<std::shared_ptr<Graph>>(
+        [&graphs](void*, std::shared_ptr<Graph>& graph) {
+            if (graph && std::find(graphs.begin(), graphs.end(), graph) == graphs.end()) {
+                graphs.push_back(graph);
+            }
+        });
+
+    std::set<const Node*> seen;
+    for (const auto& graph : graphs) {
+        if (graph->GetEnv()) {
+            graph->GetEnv()->Wait(); // No compute may run while nodes are swapped
+        }
+
+        std::set<std::string> affected_ids;
+        for (const auto& [id, node] : graph->GetNodes()) {
+            if (!node || classes.count(node->GetClass()) == 0) {
+                continue;
+            }
+            affected_ids.insert(std::string(node->ID()));
+            seen.insert(node.get());
+            record_outputs(plan, *node);
+            plan.nodes.push_back({graph, node->GetEnv(), std::string(node->ID()),
+                                  node->GetName(), node->GetClass(), node->Save(), node.get(),
+                                  node, nullptr});
+        }
+        if (affected_ids.empty()) {
+            continue;
+        }
+        ++plan.graphs_affected;
+
+        std::set<std::string> recorded;
+        for (const auto& [id, connection] : graph->GetConnections()) {
+            std::string start_id = std::string(connection->StartNodeID());
+            std::string end_id = std::string(connection->EndNodeID());
+            if (affected_ids.count(start_id) == 0 && affected_ids.count(end_id) == 0) {
+                continue;
+            }
+            if (!recorded.insert(std::string(connection->ID())).second) {
+                continue;
+            }
+            plan.connections.push_back({graph, start_id, std::string(connection->StartPortKey()),
+                                        end_id, std::string(connection->EndPortKey())});
+        }
+    }
+
+    // Nodes held only by handles (created through the factory, never added to a graph)
+    auto visit_node = [&](void* handle, const SharedNode& node, bool shared_node) {
+        if (!node || classes.count(node->GetClass()) == 0) {
+            return;
+        }
+        plan.handles.push_back({handle, shared_node, node.get()});
+        if (seen.insert(node.get()).second) {
+            record_outputs(plan, *node);
+            plan.nodes.push_back({nullptr, node->GetEnv(), std::string(node->ID()),
+                                  node->GetName(), node->GetClass(), node->Save(), node.get(),
+                                  node, nullptr});
+        }
+    };
+    flow_ffi::for_each_handle<NodeWrapper>(
+        [&](void* handle, NodeWrapper& wrapper) { visit_node(handle, wrapper.get(), false); });
+    flow_ffi::for_each_handle<SharedNode>([&](void* handle, SharedNode& node) {
+        visit_node(handle, flow_ffi::load_node(node), true);
+    });
+
+    return plan;
+}
+
+void repoint_handles(const ReloadPlan& plan, const std::map<const Node*, SharedNode>& nodes) {
+    for (const auto& h : plan.handles) {
+        auto it = nodes.find(h.old_address);
+        SharedNode node = it != nodes.end() ? it->second : nullptr;
+        if (h.shared_node) {
+            if (auto* ptr = flow_ffi::get_handle<SharedNode>(h.handle)) {
+                flow_ffi::store_node(*ptr, std::move(node));
+            }
+        } else if (auto* wrapper = flow_ffi::get_handle<NodeWrapper>(h.handle)) {
+            wrapper->set(std::move(node));
+        }
+    }
+}
+
+// Clears the ports of other nodes in the planned graphs that hold a value computed by a
+// planned node; the values are kept in plan.held until the detach is checked
+void clear_held_values(ReloadPlan& plan) {
+    std::set<const NodeData*> values;
+    for (const auto& value : plan.values) {
+        if (auto data = value.lock()) {
+            values.insert(data.get());
+        }
+    }
+    if (values.empty()) {
+        return;
+    }
+
+    std::set<const Node*> planned;
+    std::set<std::shared_ptr<Graph>> graphs;
+    for (const auto& n : plan.nodes) {
+        planned.insert(n.old_address);
+        if (n.graph) {
+            graphs.insert(n.graph);
+        }
+    }
+
+    for (const auto& graph : graphs) {
+        for (const auto& [id, node] : graph->GetNodes()) {
+            if (!node || planned.count(node.get()) > 0) {
+                continue;
+            }
+            for (bool input : {true, false}) {
+                for (const auto& [key, port] : input ? node->GetInputPorts()
+                                                     : node->GetOutputPorts()) {
+                    if (port && values.count(port->GetData().get()) > 0) {
+                        plan.held.push_back({node, key, input, port->GetData()});
+                    }
+                }
+            }
+        }
+    }
+    for (const auto& h : plan.held) {
+        if (h.input) {
+            h.node->SetInputData(h.key, nullptr, false);
+        } else {
+            h.node->SetOutputData(h.key, nullptr, false);
+        }
+    }
+}
+
+// True if nothing but plan.held still references a value computed by a planned node
+bool values_released(const ReloadPlan& plan) {
+    std::map<const NodeData*, long> held_refs;
+    for (const auto& h : plan.held) {
+        ++held_refs[h.data.get()];
+    }
+    return std::all_of(plan.values.begin(), plan.values.end(), [&](const auto& value) {
+        auto data = value.lock();
+        return !data || data.use_count() - 1 == held_refs[data.get()];
+    });
+}
+
+// Removes the planned nodes from graphs and handles, and the values they computed from
+// the ports of other nodes. Returns false (and undoes the detach) if something else
+// still holds one of the old nodes or their values, whose code is about to be unloaded.
+bool detach_nodes(ReloadPlan& plan) {
+    clear_held_values(plan);
+    for (const auto& n : plan.nodes) {
+        if (n.graph) {
+            n.graph->RemoveNodeByID(UUID(n.id));
+        }
+    }
+    repoint_handles(plan, {});
+
+    bool released = std::all_of(plan.nodes.begin(), plan.nodes.end(),
+                                [](const auto& n) { return n.old_node.expired(); }) &&
+                    values_released(plan);
+    if (released) {
+        plan.held.clear(); // Destroyed while the library is still loaded
+        return true;
+    }
+
+    std::map<const Node*, SharedNode> restored;
+    for (auto& n : plan.nodes) {
+        if (auto node = n.old_node.lock()) {
+            if (n.graph) {
+                n.graph->AddNode(node);
+            }
+            restored[n.old_address] = std::move(node);
+        }
+    }
+    for (const auto& c : plan.connections) {
+        try {
+            c.graph->ConnectNodes(UUID(c.start_id), IndexableName{c.start_key},
+                                  UUID(c.end_id), IndexableName{c.end_key});
+        } catch (const std::exception&) {
+        }
+    }
+    repoint_handles(plan, restored);
+    for (const auto& h : plan.held) {
+        if (h.input) {
+            h.node->SetInputData(h.key, h.data, false);
+        } else {
+            h.node->SetOutputData(h.key, h.data, false);
+        }
+    }
+    plan.held.clear();
+    return false;
+}
+
+FlowModuleLoadStats to_load_stats(const ModuleWrapper& wrapper) {
+    FlowModuleLoadStats stats{};
+    stats.manifest_time_ms = wrapper.stats.manifest_time_ms;
+    stats.load_time_ms = wrapper.stats.load_time_ms;
+    stats.register_time_ms = wrapper.stats.register_time_ms;
+    stats.reload_time_ms = wrapper.stats.reload_time_ms;
+    stats.shared_objects_loaded = wrapper.stats.shared_objects;
+    stats.dynamic_symbols = wrapper.stats.dynamic_symbols;
+    stats.node_classes_registered = wrapper.registered ? wrapper.node_classes.size() : 0;
+    stats.load_count = wrapper.stats.load_count;
+    stats.lazy = wrapper.lazy;
+    stats.from_index = wrapper.stats.from_index;
+    stats.resident = wrapper.module->IsLoaded();
+    return stats;
+}
+
+// A metadata field of a module, read under the module's lock because a reload or a
+// materialization replaces the metadata and manifest. Interned, so the pointer stays
+// valid after that. Deferred modules answer from the manifest read at load time.
+template <typename FromMetaData, typename FromManifest>
+const char* module_metadata_field(FlowModuleHandle module, FromMetaData from_metadata,
+                                  FromManifest from_manifest) {
+    try {
+        flow_ffi::ErrorManager::instance().clear_error();
+
+        if (!module) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
+                                                         "Invalid module handle");
+            return nullptr;
+        }
+
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Invalid module handle");
+            return nullptr;
+        }
+
+        auto wrapper = *module_ptr;
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+        const auto& metadata = wrapper->module->GetMetaData();
+        if (metadata) {
+            return flow_ffi::intern(from_metadata(*metadata));
+        }
+        if (wrapper->manifest) {
+            return flow_ffi::intern(from_manifest(*wrapper->manifest));
+        }
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
+                                                     "No metadata available");
+        return nullptr;
+
+    } catch (const std::exception& e) {
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_UNKNOWN, e.what());
+        return nullptr;
+    }
+}
+
+} // namespace
+
+namespace flow_ffi {
+
+std::string node_class_build_id(const NodeFactory* factory, const std::string& class_name) {
+    std::lock_guard<std::mutex> lock(g_build_ids_mutex);
+    auto it = g_build_ids.find({factory, class_name});
+    return it != g_build_ids.end() ? it->second : std::string();
+}
+
+std::mutex& factory_registration_mutex(const NodeFactory* factory) {
+    static std::mutex registry_mutex;
+    static std::unordered_map<const NodeFactory*, std::unique_ptr<std::mutex>> mutexes;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& mutex = mutexes[factory];
+    if (!mutex) {
+        mutex = std::make_unique<std::mutex>();
+    }
+    return *mutex;
+}
+
+bool resolve_lazy_node_class(const std::shared_ptr<NodeFactory>& factory,
+                             const std::string& class_name) {
+    auto modules = lazy_modules_of(factory.get());
+
+    // Modules that declare the class first, then modules whose classes are still unknown
+    std::stable_partition(modules.begin(), modules.end(), [&class_name](const auto& wrapper) {
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+        return std::any_of(wrapper->node_classes.begin(), wrapper->node_classes.end(),
+                           [&class_name](const auto& entry) {
+                               return entry.class_name == class_name;
+                           });
+    });
+
+    for (const auto& wrapper : modules) {
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+        if (!wrapper->register_pending) {
+            continue;
+        }
+
+        bool declared = std::any_of(
+            wrapper->node_classes.begin(), wrapper->node_classes.end(),
+            [&class_name](const auto& entry) { return entry.class_name == class_name; });
+        if (!declared && !wrapper->node_classes.empty()) {
+            continue;
+        }
+
+        try {
+            materialize(*wrapper);
+        } catch (const std::exception&) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> factory_lock(factory_registration_mutex(factory.get()));
+        if (is_class_registered(*factory, class_name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> resolve_lazy_node_classes(const std::shared_ptr<NodeFactory>& factory,
+                                                   const std::vector<std::string>& class_names) {
+    std::vector<std::string> missing;
+    for (const auto& class_name : class_names) {
+        {
+            std::lock_guard<std::mutex> lock(factory_registration_mutex(factory.get()));
+            if (is_class_registered(*factory, class_name)) {
+                continue;
+            }
+        }
+        if (!resolve_lazy_node_class(factory, class_name)) {
+            missing.push_back(class_name);
+        }
+    }
+    return missing;
+}
+
+std::vector<NodeClassEntry> lazy_node_classes(const NodeFactory* factory) {
+    std::vector<NodeClassEntry> classes;
+    for (const auto& wrapper : lazy_modules_of(factory)) {
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+        if (wrapper->register_pending) {
+            classes.insert(classes.end(), wrapper->node_classes.begin(),
+                           wrapper->node_classes.end());
+        }
+    }
+    return classes;
+}
+
+} // namespace flow_ffi
+
 extern "C" {
 
 // ============================================================================
@@ -35,9 +721,10 @@ FLOW_FFI_EXPORT FlowModuleHandle flow_module_create(FlowNodeFactoryHandle factor
             return nullptr;
         }
 
-        auto module = std::make_shared<Module>(factory_wrapper->factory);
+        auto wrapper = std::make_shared<ModuleWrapper>(
+            std::make_shared<Module>(factory_wrapper->factory), factory_wrapper->factory);
         return static_cast<FlowModuleHandle>(
-            flow_ffi::create_handle<std::shared_ptr<Module>>(std::move(module)));
+            flow_ffi::create_handle<std::shared_ptr<ModuleWrapper>>(std::move(wrapper)));
 
     } catch (const std::exception& e) {
         flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_OUT_OF_MEMORY, e.what());
@@ -68,8 +755,8 @@ FLOW_FFI_EXPORT FlowError flow_module_load(FlowModuleHandle module, const char*
             return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
             return FLOW_ERROR_INVALID_HANDLE;
@@ -82,7 +769,16 @@ FLOW_FFI_EXPORT FlowError flow_module_load(FlowModuleHandle module, const char*
             return FLOW_ERROR_MODULE_LOAD_FAILED;
         }
 
-        bool success = (*module_ptr)->Load(module_path);
+        auto& wrapper = *module_ptr;
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+
+        if (wrapper->lazy) {
+            // Only the manifest is read now; the library is loaded on first use
+            defer_load(wrapper, module_path);
+            return FLOW_SUCCESS;
+        }
+
+        bool success = load_library(*wrapper, module_path);
         if (!success) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
                                                          "Failed to load module");
@@ -107,20 +803,28 @@ FLOW_FFI_EXPORT FlowError flow_module_unload(FlowModuleHandle module) {
             return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
+        auto& wrapper = *module_ptr;
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+
+        // A deferred module was never loaded; dropping the pending work is enough
+        wrapper->load_pending = false;
+        wrapper->register_pending = false;
+
         // Check if module is loaded first
-        if (!(*module_ptr)->IsLoaded()) {
+        if (!wrapper->module->IsLoaded()) {
             // Unloading a module that's not loaded is a no-op and should succeed
             return FLOW_SUCCESS;
         }
 
-        bool success = (*module_ptr)->Unload();
+        wrapper->registered = false;
+        bool success = wrapper->module->Unload();
         if (!success) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
                                                          "Failed to unload module");
@@ -145,20 +849,31 @@ FLOW_FFI_EXPORT FlowError flow_module_register_nodes(FlowModuleHandle module) {
             return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        if (!(*module_ptr)->IsLoaded()) {
+        auto& wrapper = *module_ptr;
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+
+        if (wrapper->load_pending) {
+            // Registered when the first node of one of its classes is created
+            wrapper->register_pending = true;
+            return FLOW_SUCCESS;
+        }
+
+        if (!wrapper->module->IsLoaded()) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
                                                          "Module is not loaded");
             return FLOW_ERROR_MODULE_LOAD_FAILED;
         }
 
-        (*module_ptr)->RegisterModuleNodes();
+        std::lock_guard<std::mutex> factory_lock(
+            flow_ffi::factory_registration_mutex(wrapper->factory.get()));
+        register_and_record(*wrapper);
         return FLOW_SUCCESS;
 
     } catch (const std::exception& e) {
@@ -177,20 +892,31 @@ FLOW_FFI_EXPORT FlowError flow_module_unregister_nodes(FlowModuleHandle module)
             return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        if (!(*module_ptr)->IsLoaded()) {
+        auto& wrapper = *module_ptr;
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+
+        if (wrapper->load_pending) {
+            wrapper->register_pending = false;
+            return FLOW_SUCCESS;
+        }
+
+        if (!wrapper->module->IsLoaded()) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
                                                          "Module is not loaded");
             return FLOW_ERROR_MODULE_LOAD_FAILED;
         }
 
-        (*module_ptr)->UnregisterModuleNodes();
+        std::lock_guard<std::mutex> factory_lock(
+            flow_ffi::factory_registration_mutex(wrapper->factory.get()));
+        wrapper->module->UnregisterModuleNodes();
+        wrapper->registered = false;
         return FLOW_SUCCESS;
 
     } catch (const std::exception& e) {
@@ -205,140 +931,342 @@ FLOW_FFI_EXPORT bool flow_module_is_loaded(FlowModuleHandle module) {
             return false;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             return false;
         }
 
-        return (*module_ptr)->IsLoaded();
+        // A deferred module counts as loaded; see flow_module_is_resident
+        std::lock_guard<std::mutex> lock((*module_ptr)->mutex);
+        return (*module_ptr)->load_pending || (*module_ptr)->module->IsLoaded();
 
     } catch (const std::exception&) {
         return false;
     }
 }
 
-FLOW_FFI_EXPORT const char* flow_module_get_name(FlowModuleHandle module) {
+FLOW_FFI_EXPORT bool flow_module_is_resident(FlowModuleHandle module) {
+    try {
+        if (!module) {
+            return false;
+        }
+
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock((*module_ptr)->mutex);
+        return (*module_ptr)->module->IsLoaded();
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+FLOW_FFI_EXPORT FlowError flow_module_set_lazy(FlowModuleHandle module, bool lazy) {
     try {
         flow_ffi::ErrorManager::instance().clear_error();
 
         if (!module) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
                                                          "Invalid module handle");
-            return nullptr;
+            return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
-            return nullptr;
-        }
-
-        const auto& metadata = (*module_ptr)->GetMetaData();
-        if (!metadata) {
-            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
-                                                         "No metadata available");
-            return nullptr;
+            return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        // Return pointer to internal string - valid as long as module exists
-        return metadata->Name.c_str();
+        std::lock_guard<std::mutex> lock((*module_ptr)->mutex);
+        (*module_ptr)->lazy = lazy;
+        return FLOW_SUCCESS;
 
     } catch (const std::exception& e) {
         flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_UNKNOWN, e.what());
-        return nullptr;
+        return FLOW_ERROR_UNKNOWN;
     }
 }
 
-FLOW_FFI_EXPORT const char* flow_module_get_version(FlowModuleHandle module) {
+FLOW_FFI_EXPORT FlowError flow_module_materialize(FlowModuleHandle module) {
     try {
         flow_ffi::ErrorManager::instance().clear_error();
 
         if (!module) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
                                                          "Invalid module handle");
-            return nullptr;
+            return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
-            return nullptr;
+            return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        const auto& metadata = (*module_ptr)->GetMetaData();
-        if (!metadata) {
+        std::lock_guard<std::mutex> lock((*module_ptr)->mutex);
+        if (!materialize(**module_ptr)) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
-                                                         "No metadata available");
-            return nullptr;
+                                                         "Failed to load module");
+            return FLOW_ERROR_MODULE_LOAD_FAILED;
         }
-
-        return metadata->Version.c_str();
+        return FLOW_SUCCESS;
 
     } catch (const std::exception& e) {
-        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_UNKNOWN, e.what());
-        return nullptr;
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED, e.what());
+        return FLOW_ERROR_MODULE_LOAD_FAILED;
     }
 }
 
-FLOW_FFI_EXPORT const char* flow_module_get_author(FlowModuleHandle module) {
+FLOW_FFI_EXPORT FlowError flow_module_reload(FlowModuleHandle module,
+                                             FlowModuleReloadStats* stats) {
     try {
         flow_ffi::ErrorManager::instance().clear_error();
 
         if (!module) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
                                                          "Invalid module handle");
-            return nullptr;
+            return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
-            return nullptr;
+            return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        const auto& metadata = (*module_ptr)->GetMetaData();
-        if (!metadata) {
+        FlowModuleReloadStats result{};
+        auto total_start = std::chrono::steady_clock::now();
+
+        auto wrapper = *module_ptr;
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+
+        if (wrapper->load_pending) {
+            // Nothing is resident yet, the next materialization picks up the new files
+            wrapper->manifest = read_manifest(wrapper->path);
+            if (stats) {
+                *stats = result;
+            }
+            return FLOW_SUCCESS;
+        }
+
+        if (!wrapper->module->IsLoaded() || wrapper->path.empty()) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
-                                                         "No metadata available");
-            return nullptr;
+                                                         "Module is not loaded");
+            return FLOW_ERROR_MODULE_LOAD_FAILED;
+        }
+        if (!fs::exists(wrapper->path)) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
+                                                         "Module path does not exist");
+            return FLOW_ERROR_MODULE_LOAD_FAILED;
         }
 
-        return metadata->Author.c_str();
+        // No other bridge call may change a graph's topology until the nodes are restored
+        auto graph_guards = flow_ffi::lock_open_graphs();
+
+        // Snapshots, workers and computed values hold objects built by the module's code,
+        // which must all be gone before its library is unloaded
+        for (auto& guard : graph_guards) {
+            guard.discard_snapshot();
+        }
+        if (!flow_ffi::release_executor_state()) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_MODULE_LOAD_FAILED, "Module nodes are in use by a running context");
+            return FLOW_ERROR_MODULE_LOAD_FAILED;
+        }
+
+        // 1. Save and detach every node created from this module
+        auto phase_start = std::chrono::steady_clock::now();
+        std::set<std::string> classes;
+        for (const auto& entry : wrapper->node_classes) {
+            classes.insert(entry.class_name);
+        }
+        auto plan = plan_reload(classes);
+        if (!detach_nodes(plan)) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_MODULE_LOAD_FAILED,
+                "Module nodes or values they computed are still referenced outside graphs");
+            return FLOW_ERROR_MODULE_LOAD_FAILED;
+        }
+        result.save_time_ms = elapsed_ms(phase_start);
+
+        // 2. Swap the shared library
+        phase_start = std::chrono::steady_clock::now();
+        bool was_registered = wrapper->registered;
+        bool loaded = false;
+        {
+            std::lock_guard<std::mutex> factory_lock(
+                flow_ffi::factory_registration_mutex(wrapper->factory.get()));
+            if (was_registered) {
+                wrapper->module->UnregisterModuleNodes();
+                wrapper->registered = false;
+            }
+            wrapper->module->Unload();
+
+            loaded = load_library(*wrapper, wrapper->path);
+            if (loaded && was_registered) {
+                register_and_record(*wrapper);
+            }
+        }
+        result.swap_time_ms = elapsed_ms(phase_start);
+
+        // 3. Re-create the nodes with their ids, names and saved state, then reconnect
+        phase_start = std::chrono::steady_clock::now();
+        std::map<const Node*, SharedNode> migrated;
+        for (auto& n : plan.nodes) {
+            if (loaded) {
+                n.new_node = wrapper->factory->CreateNode(n.class_name, UUID(n.id), n.name, n.env);
+            }
+            if (!n.new_node) {
+                ++result.nodes_dropped;
+                continue;
+            }
+
+            try {
+                n.new_node->Restore(n.state);
+            } catch (const std::exception&) {
+                // Incompatible state: keep the node with its defaults
+            }
+            if (n.graph) {
+                n.graph->AddNode(n.new_node);
+            }
+            migrated[n.old_address] = n.new_node;
+            ++result.nodes_migrated;
+        }
+
+        for (const auto& c : plan.connections) {
+            try {
+                c.graph->ConnectNodes(UUID(c.start_id), IndexableName{c.start_key},
+                                      UUID(c.end_id), IndexableName{c.end_key});
+                ++result.connections_restored;
+            } catch (const std::exception&) {
+                ++result.connections_dropped;
+            }
+        }
+        repoint_handles(plan, migrated);
+        result.restore_time_ms = elapsed_ms(phase_start);
+
+        result.graphs_affected = plan.graphs_affected;
+        result.total_time_ms = elapsed_ms(total_start);
+        wrapper->stats.reload_time_ms = result.total_time_ms;
+        if (stats) {
+            *stats = result;
+        }
+
+        if (!loaded) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
+                                                         "Failed to load the new module version");
+            return FLOW_ERROR_MODULE_LOAD_FAILED;
+        }
+        return FLOW_SUCCESS;
 
     } catch (const std::exception& e) {
-        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_UNKNOWN, e.what());
-        return nullptr;
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED, e.what());
+        return FLOW_ERROR_MODULE_LOAD_FAILED;
     }
 }
 
-FLOW_FFI_EXPORT const char* flow_module_get_description(FlowModuleHandle module) {
+FLOW_FFI_EXPORT FlowError flow_module_get_load_stats(FlowModuleHandle module,
+                                                     FlowModuleLoadStats* stats) {
     try {
         flow_ffi::ErrorManager::instance().clear_error();
 
-        if (!module) {
+        if (!module || !stats) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT,
-                                                         "Invalid module handle");
-            return nullptr;
+                                                         "Invalid module handle or stats");
+            return FLOW_ERROR_INVALID_ARGUMENT;
         }
 
-        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<Module>>(module);
-        if (!module_ptr) {
+        auto* module_ptr = flow_ffi::get_handle<std::shared_ptr<ModuleWrapper>>(module);
+        if (!module_ptr || !*module_ptr) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid module handle");
-            return nullptr;
+            return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        const auto& metadata = (*module_ptr)->GetMetaData();
-        if (!metadata) {
-            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
-                                                         "No metadata available");
-            return nullptr;
+        std::lock_guard<std::mutex> lock((*module_ptr)->mutex);
+        *stats = to_load_stats(**module_ptr);
+        return FLOW_SUCCESS;
+
+    } catch (const std::exception& e) {
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_UNKNOWN, e.what());
+        return FLOW_ERROR_UNKNOWN;
+    }
+}
+
+FLOW_FFI_EXPORT char* flow_modules_get_load_report(void) {
+    try {
+        flow_ffi::ErrorManager::instance().clear_error();
+
+        // Collect first: wrapper mutexes must not be taken under the registry lock
+        std::vector<std::shared_ptr<ModuleWrapper>> wrappers;
+        flow_ffi::for_each_handle<std::shared_ptr<ModuleWrapper>>(
+            [&wrappers](void*, std::shared_ptr<ModuleWrapper>& wrapper) {
+                if (wrapper) {
+                    wrappers.push_back(wrapper);
+                }
+            });
+
+        nlohmann::json modules = nlohmann::json::array();
+        FlowModuleLoadStats totals{};
+        std::size_t resident = 0;
+        for (const auto& wrapper : wrappers) {
+            std::lock_guard<std::mutex> lock(wrapper->mutex);
+            auto stats = to_load_stats(*wrapper);
+
+            std::string name;
+            if (const auto& metadata = wrapper->module->GetMetaData()) {
+                name = metadata->Name;
+            } else if (wrapper->manifest) {
+                name = wrapper->manifest->name;
+            }
+
+            modules.push_back({{"Path", wrapper->path.string()},
+                               {"Name", name},
+                               {"Resident", stats.resident},
+                               {"Lazy", stats.lazy},
+                               {"FromIndex", stats.from_index},
+                               {"LoadCount", stats.load_count},
+                               {"ManifestTimeMs", stats.manifest_time_ms},
+                               {"LoadTimeMs", stats.load_time_ms},
+                               {"RegisterTimeMs", stats.register_time_ms},
+                               {"ReloadTimeMs", stats.reload_time_ms},
+                               {"SharedObjects", stats.shared_objects_loaded},
+                               {"DynamicSymbols", stats.dynamic_symbols},
+                               {"NodeClasses", stats.node_classes_registered}});
+
+            totals.manifest_time_ms += stats.manifest_time_ms;
+            totals.load_time_ms += stats.load_time_ms;
+            totals.register_time_ms += stats.register_time_ms;
+            totals.shared_objects_loaded += stats.shared_objects_loaded;
+            totals.dynamic_symbols += stats.dynamic_symbols;
+            totals.node_classes_registered += stats.node_classes_registered;
+            resident += stats.resident ? 1 : 0;
         }
 
-        return metadata->Description.c_str();
+        // Slowest modules first
+        std::sort(modules.begin(), modules.end(), [](const auto& a, const auto& b) {
+            return a["LoadTimeMs"].template get<double>() +
+                       a["RegisterTimeMs"].template get<double>() >
+                   b["LoadTimeMs"].template get<double>() +
+                       b["RegisterTimeMs"].template get<double>();
+        });
+
+        nlohmann::json report = {{"ModuleCount", wrappers.size()},
+                                 {"ResidentCount", resident},
+                                 {"ManifestTimeMs", totals.manifest_time_ms},
+                                 {"LoadTimeMs", totals.load_time_ms},
+                                 {"RegisterTimeMs", totals.register_time_ms},
+                                 {"SharedObjects", totals.shared_objects_loaded},
+                                 {"DynamicSymbols", totals.dynamic_symbols},
+                                 {"NodeClasses", totals.node_classes_registered},
+                                 {"Modules", std::move(modules)}};
+        return flow_ffi::copy_string(report.dump(2));
 
     } catch (const std::exception& e) {
         flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_UNKNOWN, e.what());
@@ -346,4 +1274,248 @@ FLOW_FFI_EXPORT const char* flow_module_get_description(FlowModuleHandle module)
     }
 }
 
+FLOW_FFI_EXPORT const char* flow_module_get_name(FlowModuleHandle module) {
+    return module_metadata_field(
+        module, [](const auto& metadata) -> const std::string& { return metadata.Name; },
+        [](const ModuleManifest& manifest) -> const std::string& { return manifest.name; });
+}
+
+FLOW_FFI_EXPORT const char* flow_module_get_version(FlowModuleHandle module) {
+    return module_metadata_field(
+        module, [](const auto& metadata) -> const std::string& { return metadata.Version; },
+        [](const ModuleManifest& manifest) -> const std::string& { return manifest.version; });
+}
+
+FLOW_FFI_EXPORT const char* flow_module_get_author(FlowModuleHandle module) {
+    return module_metadata_field(
+        module, [](const auto& metadata) -> const std::string& { return metadata.Author; },
+        [](const ModuleManifest& manifest) -> const std::string& { return manifest.author; });
+}
+
+FLOW_FFI_EXPORT const char* flow_module_get_description(FlowModuleHandle module) {
+    return module_metadata_field(
+        module,
+        [](const auto& metadata) -> const std::string& { return metadata.Description; },
+        [](const ModuleManifest& manifest) -> const std::string& {
+            return manifest.description;
+        });
+}
+
+// ============================================================================
+// Batch Module Loading
+// ============================================================================
+
+FLOW_FFI_EXPORT FlowError flow_modules_load_directory(FlowNodeFactoryHandle factory,
+                                                      const char* directory,
+                                                      const FlowModuleLoadOptions* options,
+                                                      FlowModuleLoadResult** results,
+                                                      size_t* count) {
+    try {
+        flow_ffi::ErrorManager::instance().clear_error();
+
+        if (!directory || !results || !count) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_INVALID_ARGUMENT, "Invalid directory, results or count argument");
+            return FLOW_ERROR_INVALID_ARGUMENT;
+        }
+        *results = nullptr;
+        *count = 0;
+
+        auto* factory_wrapper = flow_ffi::get_handle<NodeFactoryWrapper>(factory);
+        if (!factory_wrapper || !factory_wrapper->factory) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                         "Invalid factory handle");
+            return FLOW_ERROR_INVALID_HANDLE;
+        }
+
+        FlowModuleLoadOptions opts{0, true, true, false, nullptr};
+        if (options) {
+            opts = *options;
+        }
+
+        fs::path dir_path(directory);
+        if (!fs::is_directory(dir_path)) {
+            flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED,
+                                                         "Module directory does not exist");
+            return FLOW_ERROR_MODULE_LOAD_FAILED;
+        }
+
+        // Discover modules; sorting gives a deterministic registration order
+        std::vector<PendingModuleLoad> pending;
+        for (const auto& entry : fs::directory_iterator(dir_path)) {
+            if (entry.path().extension() == ".fmod") {
+                PendingModuleLoad load;
+                load.path = entry.path();
+                load.wrapper = std::make_shared<ModuleWrapper>(
+                    std::make_shared<Module>(factory_wrapper->factory), factory_wrapper->factory);
+                pending.push_back(std::move(load));
+            }
+        }
+        std::sort(pending.begin(), pending.end(),
+                  [](const auto& a, const auto& b) { return a.path < b.path; });
+
+        if (pending.empty()) {
+            return FLOW_SUCCESS;
+        }
+
+        // Unchanged modules are deferred with the classes recorded in the index
+        flow_ffi::ModuleIndex index;
+        bool use_index = opts.index_path && *opts.index_path;
+        if (use_index) {
+            index.load(opts.index_path);
+            for (auto& p : pending) {
+                p.fingerprint = flow_ffi::module_fingerprint(p.path);
+                const auto* entry = p.fingerprint ? index.find_fresh(p.path, *p.fingerprint)
+                                                  : nullptr;
+                if (entry) {
+                    std::lock_guard<std::mutex> lock(p.wrapper->mutex);
+                    defer_from_index(p.wrapper, p.path, *entry);
+                    p.wrapper->register_pending = opts.register_nodes;
+                    p.indexed = true;
+                    p.loaded = true;
+                }
+            }
+        }
+
+        if (opts.lazy) {
+            // Only the manifests are read; modules load when one of their classes is needed
+            for (auto& p : pending) {
+                if (p.indexed) {
+                    continue;
+                }
+                auto start = std::chrono::steady_clock::now();
+                std::lock_guard<std::mutex> lock(p.wrapper->mutex);
+                p.wrapper->lazy = true;
+                defer_load(p.wrapper, p.path);
+                p.wrapper->register_pending = opts.register_nodes;
+                p.loaded = true;
+                p.load_time_ms = elapsed_ms(start);
+            }
+        } else {
+            load_in_parallel(pending, opts);
+        }
+
+        auto first_failure = std::find_if(pending.begin(), pending.end(), [](const auto& p) {
+            return p.error != FLOW_SUCCESS;
+        });
+        bool rollback = first_failure != pending.end() && !opts.continue_on_error;
+
+        if (rollback) {
+            // Modules that loaded fine are reported as failed too, none of them is kept
+            const std::string reason = "Rolled back: " + first_failure->path.string() +
+                                       " failed to load";
+            for (auto& p : pending) {
+                if (p.loaded && p.wrapper->module->IsLoaded()) {
+                    p.wrapper->module->Unload();
+                }
+                if (p.error == FLOW_SUCCESS) {
+                    p.error = FLOW_ERROR_MODULE_LOAD_FAILED;
+                    p.error_message = reason;
+                }
+                p.loaded = false;
+            }
+        } else if (opts.register_nodes && !opts.lazy) {
+            // The wrappers are not shared yet, so only the factory lock is taken
+            std::lock_guard<std::mutex> lock(
+                flow_ffi::factory_registration_mutex(factory_wrapper->factory.get()));
+            for (auto& p : pending) {
+                if (!p.loaded || p.indexed) {
+                    continue;
+                }
+                auto start = std::chrono::steady_clock::now();
+                try {
+                    register_and_record(*p.wrapper);
+                } catch (const std::exception& e) {
+                    p.error = FLOW_ERROR_MODULE_LOAD_FAILED;
+                    p.error_message = e.what();
+
+                    // No handle is returned for it, so nothing else would ever unload it.
+                    // Classes registered before the throw must not outlive the library.
+                    try {
+                        p.wrapper->module->UnregisterModuleNodes();
+                    } catch (const std::exception&) {
+                        // Unload regardless
+                    }
+                    p.wrapper->registered = false;
+                    p.wrapper->module->Unload();
+                    p.loaded = false;
+                }
+                p.register_time_ms = elapsed_ms(start);
+            }
+        }
+
+        if (use_index && !rollback) {
+            // Only modules that were loaded and registered have known classes
+            std::vector<fs::path> scanned;
+            for (auto& p : pending) {
+                scanned.push_back(p.path);
+                const auto& metadata = p.wrapper->module->GetMetaData();
+                bool registered = opts.register_nodes && !opts.lazy;
+                if (p.indexed || !p.loaded || p.error != FLOW_SUCCESS || !p.fingerprint ||
+                    !registered || !metadata) {
+                    continue;
+                }
+
+                flow_ffi::ModuleIndexEntry entry;
+                entry.fingerprint = *p.fingerprint;
+                entry.manifest = {metadata->Name, metadata->Version, metadata->Author,
+                                  metadata->Description};
+                entry.node_classes = p.wrapper->node_classes;
+                index.update(p.path, std::move(entry));
+            }
+            index.retain(scanned);
+
+            // A stale index only costs startup time, so a failed write is not an error
+            if (index.dirty()) {
+                index.save(opts.index_path);
+            }
+        }
+
+        *results = flow_ffi::alloc_array<FlowModuleLoadResult>(pending.size());
+        *count = pending.size();
+
+        FlowError status = FLOW_SUCCESS;
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            auto& p = pending[i];
+            auto& result = (*results)[i];
+            result.path = flow_ffi::copy_string(p.path.string());
+            result.error_message =
+                p.error_message.empty() ? nullptr : flow_ffi::copy_string(p.error_message);
+            result.error = p.error;
+            result.load_time_ms = p.load_time_ms;
+            result.register_time_ms = p.register_time_ms;
+            result.module = nullptr;
+
+            if (p.loaded && p.error == FLOW_SUCCESS) {
+                result.module = static_cast<FlowModuleHandle>(
+                    flow_ffi::create_handle<std::shared_ptr<ModuleWrapper>>(p.wrapper));
+            }
+
+            if (p.error != FLOW_SUCCESS && status == FLOW_SUCCESS) {
+                status = p.error;
+                flow_ffi::ErrorManager::instance().set_error(
+                    p.error, "Failed to load module " + p.path.string() + ": " + p.error_message);
+            }
+        }
+
+        return status;
+
+    } catch (const std::exception& e) {
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_MODULE_LOAD_FAILED, e.what());
+        return FLOW_ERROR_MODULE_LOAD_FAILED;
+    }
+}
+
+FLOW_FFI_EXPORT void flow_free_module_load_results(FlowModuleLoadResult* results, size_t count) {
+    if (!results) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        flow_ffi::free_string(results[i].path);
+        flow_ffi::free_string(results[i].error_message);
+    }
+    flow_ffi::free_array(results);
+}
+
 } // extern "C"
\ No newline at end of file
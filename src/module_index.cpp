@@ -0,0 +1,222 @@
+#include "module_index.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <system_error>
+
+#include <nlohmann/json.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace flow_ffi {
+
+namespace {
+
+constexpr int kIndexVersion = 1;
+
+// Read-only view of a whole file; memory mapped on POSIX, buffered elsewhere
+class MappedFile {
+public:
+    explicit MappedFile(const fs::path& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* mapped = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                                  MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data_ = static_cast<const char*>(mapped);
+                size_ = static_cast<size_t>(st.st_size);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (file) {
+            buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (mapped_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_;
+};
+
+int64_t file_mtime(const fs::path& path, std::error_code& ec) {
+    return static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+}
+
+} // namespace
+
+std::optional<ModuleFingerprint> module_fingerprint(const fs::path& path) {
+    std::error_code ec;
+    ModuleFingerprint fingerprint;
+
+    if (fs::is_regular_file(path, ec)) {
+        fingerprint.mtime = file_mtime(path, ec);
+        fingerprint.size = fs::file_size(path, ec);
+        return ec ? std::nullopt : std::optional<ModuleFingerprint>(fingerprint);
+    }
+
+    if (!fs::is_directory(path, ec)) {
+        return std::nullopt;
+    }
+
+    fingerprint.mtime = file_mtime(path, ec);
+    for (fs::recursive_directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entry_ec;
+        fingerprint.mtime = std::max(fingerprint.mtime, file_mtime(it->path(), entry_ec));
+        if (it->is_regular_file(entry_ec)) {
+            fingerprint.size += it->file_size(entry_ec);
+        }
+    }
+    return ec ? std::nullopt : std::optional<ModuleFingerprint>(fingerprint);
+}
+
+bool ModuleIndex::load(const fs::path& index_path) {
+    entries_.clear();
+    dirty_ = false;
+
+    MappedFile file(index_path);
+    if (file.empty()) {
+        return false;
+    }
+
+    auto j = nlohmann::json::parse(file.begin(), file.end(), nullptr, false);
+    if (j.is_discarded() || !j.is_object() || j.value("Version", 0) != kIndexVersion) {
+        return false;
+    }
+
+    auto modules = j.find("Modules");
+    if (modules == j.end() || !modules->is_array()) {
+        return false;
+    }
+
+    for (const auto& m : *modules) {
+        if (!m.is_object() || !m.contains("Path")) {
+            continue;
+        }
+
+        ModuleIndexEntry entry;
+        entry.fingerprint.mtime = m.value("MTime", int64_t{0});
+        entry.fingerprint.size = m.value("Size", uint64_t{0});
+        entry.manifest.name = m.value("Name", "");
+        entry.manifest.version = m.value("Version", "");
+        entry.manifest.author = m.value("Author", "");
+        entry.manifest.description = m.value("Description", "");
+        if (auto classes = m.find("Classes"); classes != m.end() && classes->is_array()) {
+            for (const auto& c : *classes) {
+                entry.node_classes.push_back({c.value("Category", ""), c.value("Class", "")});
+            }
+        }
+        entries_[m["Path"].get<std::string>()] = std::move(entry);
+    }
+    return true;
+}
+
+bool ModuleIndex::save(const fs::path& index_path) const {
+    nlohmann::json modules = nlohmann::json::array();
+    for (const auto& [path, entry] : entries_) {
+        nlohmann::json classes = nlohmann::json::array();
+        for (const auto& c : entry.node_classes) {
+            classes.push_back({{"Category", c.category}, {"Class", c.class_name}});
+        }
+        modules.push_back({{"Path", path},
+                           {"MTime", entry.fingerprint.mtime},
+                           {"Size", entry.fingerprint.size},
+                           {"Name", entry.manifest.name},
+                           {"Version", entry.manifest.version},
+                           {"Author", entry.manifest.author},
+                           {"Description", entry.manifest.description},
+                           {"Classes", std::move(classes)}});
+    }
+
+    nlohmann::json j = {{"Version", kIndexVersion}, {"Modules", std::move(modules)}};
+
+    // Readers in other processes must never observe a partially written index
+    fs::path tmp_path = index_path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file << j.dump();
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmp_path, index_path, ec);
+    if (ec) {
+        fs::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+const ModuleIndexEntry* ModuleIndex::find_fresh(const fs::path& module_path,
+                                                const ModuleFingerprint& fingerprint) const {
+    auto it = entries_.find(module_path.string());
+    if (it == entries_.end() || !(it->second.fingerprint == fingerprint)) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void ModuleIndex::update(const fs::path& module_path, ModuleIndexEntry entry) {
+    entries_[module_path.string()] = std::move(entry);
+    dirty_ = true;
+}
+
+void ModuleIndex::retain(const std::vector<fs::path>& module_paths) {
+    std::set<std::string> keep;
+    for (const auto& path : module_paths) {
+        keep.insert(path.string());
+    }
+
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (keep.count(it->first) == 0) {
+            it = entries_.erase(it);
+            dirty_ = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace flow_ffi
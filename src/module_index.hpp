@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "module_wrapper.hpp"
+
+namespace flow_ffi {
+
+// Identity of a module on disk. For unpacked module directories the newest
+// modification time and the total size of all contained files are used.
+struct ModuleFingerprint {
+    int64_t mtime = 0;
+    uint64_t size = 0;
+
+    bool operator==(const ModuleFingerprint& other) const {
+        return mtime == other.mtime && size == other.size;
+    }
+};
+
+std::optional<ModuleFingerprint> module_fingerprint(const std::filesystem::path& path);
+
+struct ModuleIndexEntry {
+    ModuleFingerprint fingerprint;
+    ModuleManifest manifest;
+    std::vector<NodeClassEntry> node_classes;
+};
+
+// On-disk cache of module manifests and the node classes each module registers,
+// keyed by module path. Lets startup populate the factory catalog without loading
+// modules whose files have not changed.
+class ModuleIndex {
+public:
+    // Reads an index file (memory mapped where supported). A missing or corrupt file
+    // yields an empty index and returns false.
+    bool load(const std::filesystem::path& index_path);
+
+    // Writes the index atomically (temporary file + rename)
+    bool save(const std::filesystem::path& index_path) const;
+
+    // Entry for the module if its fingerprint still matches, nullptr otherwise
+    const ModuleIndexEntry* find_fresh(const std::filesystem::path& module_path,
+                                       const ModuleFingerprint& fingerprint) const;
+
+    void update(const std::filesystem::path& module_path, ModuleIndexEntry entry);
+
+    // Drops entries for modules that were not seen during the last scan
+    void retain(const std::vector<std::filesystem::path>& module_paths);
+
+    bool dirty() const { return dirty_; }
+
+private:
+    std::unordered_map<std::string, ModuleIndexEntry> entries_;
+    bool dirty_ = false;
+};
+
+} // namespace flow_ffi
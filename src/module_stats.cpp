@@ -0,0 +1,110 @@
+#include "module_stats.hpp"
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <elf.h>
+#include <link.h>
+#endif
+
+namespace flow_ffi {
+
+namespace {
+
+#if defined(__linux__)
+
+// Dynamic section pointers are relocated by glibc on most targets but not all
+template <typename T>
+const T* dyn_ptr(const dl_phdr_info* info, ElfW(Addr) ptr) {
+    return reinterpret_cast<const T*>(ptr < info->dlpi_addr ? info->dlpi_addr + ptr : ptr);
+}
+
+std::size_t count_gnu_hash_symbols(const uint32_t* table) {
+    uint32_t bucket_count = table[0];
+    uint32_t symbol_offset = table[1];
+    uint32_t bloom_size = table[2];
+    const auto* buckets = reinterpret_cast<const uint32_t*>(
+        reinterpret_cast<const ElfW(Addr)*>(table + 4) + bloom_size);
+    const uint32_t* chains = buckets + bucket_count;
+
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < bucket_count; ++i) {
+        last = buckets[i] > last ? buckets[i] : last;
+    }
+    if (last < symbol_offset) {
+        return symbol_offset;
+    }
+
+    // Walk the last chain to its terminator (low bit set)
+    while ((chains[last - symbol_offset] & 1u) == 0) {
+        ++last;
+    }
+    return last + 1;
+}
+
+std::size_t count_dynamic_symbols(const dl_phdr_info* info) {
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+        const auto& phdr = info->dlpi_phdr[i];
+        if (phdr.p_type != PT_DYNAMIC) {
+            continue;
+        }
+
+        const auto* dyn = reinterpret_cast<const ElfW(Dyn)*>(info->dlpi_addr + phdr.p_vaddr);
+        for (; dyn->d_tag != DT_NULL; ++dyn) {
+            if (dyn->d_tag == DT_GNU_HASH) {
+                return count_gnu_hash_symbols(dyn_ptr<uint32_t>(info, dyn->d_un.d_ptr));
+            }
+            if (dyn->d_tag == DT_HASH) {
+                return dyn_ptr<uint32_t>(info, dyn->d_un.d_ptr)[1]; // nchain
+            }
+        }
+    }
+    return 0;
+}
+
+struct NewObjectCount {
+    const std::set<std::string>* known;
+    std::size_t objects;
+    std::size_t symbols;
+};
+
+int collect_name(dl_phdr_info* info, size_t, void* data) {
+    if (info->dlpi_name && *info->dlpi_name) {
+        static_cast<std::set<std::string>*>(data)->insert(info->dlpi_name);
+    }
+    return 0;
+}
+
+int count_new_object(dl_phdr_info* info, size_t, void* data) {
+    auto* count = static_cast<NewObjectCount*>(data);
+    if (info->dlpi_name && *info->dlpi_name && count->known->count(info->dlpi_name) == 0) {
+        ++count->objects;
+        count->symbols += count_dynamic_symbols(info);
+    }
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+LoadedObjectSnapshot LoadedObjectSnapshot::capture() {
+    LoadedObjectSnapshot snapshot;
+#if defined(__linux__)
+    dl_iterate_phdr(collect_name, &snapshot.names_);
+#endif
+    return snapshot;
+}
+
+void LoadedObjectSnapshot::count_new(std::size_t& objects, std::size_t& symbols) const {
+    objects = 0;
+    symbols = 0;
+#if defined(__linux__)
+    NewObjectCount count{&names_, 0, 0};
+    dl_iterate_phdr(count_new_object, &count);
+    objects = count.objects;
+    symbols = count.symbols;
+#endif
+}
+
+} // namespace flow_ffi
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <string>
+
+namespace flow_ffi {
+
+// Shared objects mapped into the process, used to attribute the objects (and their
+// dynamic symbols) that a module load brought in. Empty on platforms without
+// dl_iterate_phdr.
+class LoadedObjectSnapshot {
+public:
+    static LoadedObjectSnapshot capture();
+
+    // Objects loaded since this snapshot was taken and their dynamic symbol count
+    void count_new(std::size_t& objects, std::size_t& symbols) const;
+
+private:
+    std::set<std::string> names_;
+};
+
+} // namespace flow_ffi
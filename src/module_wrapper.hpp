@@ -0,0 +1,91 @@
+#pragma once
+
+#include <flow/core/Module.hpp>
+#include <flow/core/NodeFactory.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Wrapper structure for Module handles (stored as std::shared_ptr<ModuleWrapper>).
+// Keeps the factory the module registers into, the node classes it registered and
+// the deferred state used by lazy loading.
+
+struct NodeClassEntry {
+    std::string category;
+    std::string class_name;
+};
+
+struct ModuleManifest {
+    std::string name;
+    std::string version;
+    std::string author;
+    std::string description;
+};
+
+// Per-phase load profile, reported by flow_module_get_load_stats
+struct ModuleLoadStats {
+    double manifest_time_ms = 0.0;
+    double load_time_ms = 0.0;
+    double register_time_ms = 0.0;
+    double reload_time_ms = 0.0;
+    std::size_t shared_objects = 0;
+    std::size_t dynamic_symbols = 0;
+    int32_t load_count = 0;
+    bool from_index = false;
+};
+
+struct ModuleWrapper {
+    std::shared_ptr<flow::Module> module;
+    std::shared_ptr<flow::NodeFactory> factory;
+
+    // Lazy loading: Load() only records the path and manifest, the shared library is
+    // loaded and registered the first time one of its classes is instantiated.
+    bool lazy = false;
+    bool load_pending = false;
+    bool register_pending = false;
+    bool registered = false;
+    std::filesystem::path path;
+    std::unique_ptr<ModuleManifest> manifest;
+
+    // Classes this module provides. Filled on registration; for deferred modules these
+    // are placeholder entries reported by the factory catalog.
+    std::vector<NodeClassEntry> node_classes;
+
+    ModuleLoadStats stats;
+
+    // Guards the fields above and Load/Unload/Register calls on the module
+    std::mutex mutex;
+
+    ModuleWrapper(std::shared_ptr<flow::Module> m, std::shared_ptr<flow::NodeFactory> f)
+        : module(std::move(m)), factory(std::move(f)) {}
+};
+
+namespace flow_ffi {
+
+// Version, size and modification time of the module library that last registered
+// class_name with factory; empty for classes not registered by a module
+std::string node_class_build_id(const flow::NodeFactory* factory, const std::string& class_name);
+
+// Serializes node class registration on a factory
+std::mutex& factory_registration_mutex(const flow::NodeFactory* factory);
+
+// Loads and registers deferred modules of the factory until class_name is registered.
+// Returns true if the class is available afterwards.
+bool resolve_lazy_node_class(const std::shared_ptr<flow::NodeFactory>& factory,
+                             const std::string& class_name);
+
+// resolve_lazy_node_class for each class in class_names not registered yet. Returns the
+// classes that are still unavailable.
+std::vector<std::string>
+resolve_lazy_node_classes(const std::shared_ptr<flow::NodeFactory>& factory,
+                          const std::vector<std::string>& class_names);
+
+// Placeholder classes of deferred modules that are not registered with the factory yet
+std::vector<NodeClassEntry> lazy_node_classes(const flow::NodeFactory* factory);
+
+} // namespace flow_ffi
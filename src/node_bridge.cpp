@@ -3,25 +3,16 @@
 #include <flow/core/Node.hpp>
 #include <flow/core/NodeData.hpp>
 
-#include <cstring>
-
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "node_data_wrapper.hpp"
+#include "node_wrapper.hpp"
+#include "result_memory.hpp"
+#include "string_interner.hpp"
 #include <nlohmann/json.hpp>
 
 using namespace flow;
 
-// Forward declarations for wrappers (defined in other files)
-struct NodeWrapper {
-    SharedNode node;
-    NodeWrapper(SharedNode n) : node(std::move(n)) {}
-};
-
-struct NodeDataWrapper {
-    SharedNodeData data;
-    NodeDataWrapper(SharedNodeData d) : data(std::move(d)) {}
-};
-
 extern "C" {
 
 // ============================================================================
@@ -35,18 +26,15 @@ FLOW_FFI_EXPORT const char* flow_node_get_id(FlowNodeHandle node) {
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
         }
 
-        std::string id_str = std::string(node_wrapper->node->ID());
-
-        // Allocate string that will be freed by flow_free_string
-        char* result = new char[id_str.length() + 1];
-        std::strcpy(result, id_str.c_str());
-        return result;
+        // Formatted once when the handle was created, owned by the handle
+        return node_wrapper->id.c_str();
     });
 }
 
@@ -57,18 +45,17 @@ FLOW_FFI_EXPORT const char* flow_node_get_name(FlowNodeHandle node) {
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
         }
 
-        const std::string& name = node_wrapper->node->GetName();
+        const std::string& name = target->GetName();
 
         // Allocate string that will be freed by flow_free_string
-        char* result = new char[name.length() + 1];
-        std::strcpy(result, name.c_str());
-        return result;
+        return flow_ffi::copy_string(name);
     });
 }
 
@@ -79,18 +66,14 @@ FLOW_FFI_EXPORT const char* flow_node_get_class(FlowNodeHandle node) {
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
         }
 
-        const std::string& class_name = node_wrapper->node->GetClass();
-
-        // Allocate string that will be freed by flow_free_string
-        char* result = new char[class_name.length() + 1];
-        std::strcpy(result, class_name.c_str());
-        return result;
+        return flow_ffi::intern(target->GetClass());
     });
 }
 
@@ -104,13 +87,14 @@ FLOW_FFI_EXPORT FlowError flow_node_set_name(FlowNodeHandle node, const char* na
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
-        node_wrapper->node->SetName(name);
+        target->SetName(name);
         return FLOW_SUCCESS;
     });
 }
@@ -133,7 +117,8 @@ FLOW_FFI_EXPORT FlowError flow_node_set_input_data(FlowNodeHandle node, const ch
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
@@ -148,7 +133,7 @@ FLOW_FFI_EXPORT FlowError flow_node_set_input_data(FlowNodeHandle node, const ch
 
         try {
             IndexableName key(port_key);
-            node_wrapper->node->SetInputData(key, data_wrapper->data, false); // Don't auto-compute
+            target->SetInputData(key, data_wrapper->data, false); // Don't auto-compute
             return FLOW_SUCCESS;
         } catch (const std::out_of_range&) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -173,7 +158,8 @@ FLOW_FFI_EXPORT FlowNodeDataHandle flow_node_get_input_data(FlowNodeHandle node,
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
@@ -181,7 +167,7 @@ FLOW_FFI_EXPORT FlowNodeDataHandle flow_node_get_input_data(FlowNodeHandle node,
 
         try {
             IndexableName key(port_key);
-            const SharedNodeData& data = node_wrapper->node->GetInputData(key);
+            const SharedNodeData& data = target->GetInputData(key);
 
             if (!data) {
                 return nullptr; // No data in port
@@ -215,7 +201,8 @@ FLOW_FFI_EXPORT FlowNodeDataHandle flow_node_get_output_data(FlowNodeHandle node
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
@@ -223,7 +210,7 @@ FLOW_FFI_EXPORT FlowNodeDataHandle flow_node_get_output_data(FlowNodeHandle node
 
         try {
             IndexableName key(port_key);
-            const SharedNodeData& data = node_wrapper->node->GetOutputData(key);
+            const SharedNodeData& data = target->GetOutputData(key);
 
             if (!data) {
                 return nullptr; // No data in port
@@ -256,7 +243,8 @@ FLOW_FFI_EXPORT FlowError flow_node_clear_input_data(FlowNodeHandle node, const
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
@@ -264,7 +252,7 @@ FLOW_FFI_EXPORT FlowError flow_node_clear_input_data(FlowNodeHandle node, const
 
         try {
             IndexableName key(port_key);
-            node_wrapper->node->SetInputData(key, nullptr, false); // Clear with null data
+            target->SetInputData(key, nullptr, false); // Clear with null data
             return FLOW_SUCCESS;
         } catch (const std::out_of_range&) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -288,7 +276,8 @@ FLOW_FFI_EXPORT FlowError flow_node_clear_output_data(FlowNodeHandle node, const
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
@@ -296,7 +285,7 @@ FLOW_FFI_EXPORT FlowError flow_node_clear_output_data(FlowNodeHandle node, const
 
         try {
             IndexableName key(port_key);
-            node_wrapper->node->SetOutputData(key, nullptr, false); // Clear with null data
+            target->SetOutputData(key, nullptr, false); // Clear with null data
             return FLOW_SUCCESS;
         } catch (const std::out_of_range&) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -321,14 +310,15 @@ FLOW_FFI_EXPORT FlowError flow_node_invoke_compute(FlowNodeHandle node) {
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
         try {
-            node_wrapper->node->InvokeCompute();
+            target->InvokeCompute();
             return FLOW_SUCCESS;
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -344,7 +334,8 @@ FLOW_FFI_EXPORT bool flow_node_validate_required_inputs(FlowNodeHandle node) {
     }
 
     auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-    if (!node_wrapper) {
+    SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+    if (!target) {
         flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                      "Invalid node handle");
         return false;
@@ -352,10 +343,10 @@ FLOW_FFI_EXPORT bool flow_node_validate_required_inputs(FlowNodeHandle node) {
 
     try {
         // Check if all input ports have data
-        const auto& input_ports = node_wrapper->node->GetInputPorts();
+        const auto& input_ports = target->GetInputPorts();
         for (const auto& [key, port] : input_ports) {
             try {
-                const SharedNodeData& data = node_wrapper->node->GetInputData(key);
+                const SharedNodeData& data = target->GetInputData(key);
                 if (!data) {
                     return false; // Missing required input
                 }
@@ -381,19 +372,20 @@ FLOW_FFI_EXPORT bool flow_node_has_connected_inputs(FlowNodeHandle node) {
     }
 
     auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-    if (!node_wrapper) {
+    SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+    if (!target) {
         flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                      "Invalid node handle");
         return false;
     }
 
     try {
-        const auto& input_ports = node_wrapper->node->GetInputPorts();
+        const auto& input_ports = target->GetInputPorts();
 
         // Check if any input port has data (indicating a connection)
         for (const auto& [key, port] : input_ports) {
             try {
-                const SharedNodeData& data = node_wrapper->node->GetInputData(key);
+                const SharedNodeData& data = target->GetInputData(key);
                 if (data) {
                     return true; // Found connected input
                 }
@@ -415,19 +407,20 @@ FLOW_FFI_EXPORT bool flow_node_has_connected_outputs(FlowNodeHandle node) {
     }
 
     auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-    if (!node_wrapper) {
+    SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+    if (!target) {
         flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                      "Invalid node handle");
         return false;
     }
 
     try {
-        const auto& output_ports = node_wrapper->node->GetOutputPorts();
+        const auto& output_ports = target->GetOutputPorts();
 
         // Check if any output port has data
         for (const auto& [key, port] : output_ports) {
             try {
-                const SharedNodeData& data = node_wrapper->node->GetOutputData(key);
+                const SharedNodeData& data = target->GetOutputData(key);
                 if (data) {
                     return true; // Found output with data
                 }
@@ -454,20 +447,19 @@ FLOW_FFI_EXPORT char* flow_node_save_to_json(FlowNodeHandle node) {
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
         }
 
         try {
-            json j = node_wrapper->node->Save();
+            json j = target->Save();
             std::string json_str = j.dump();
 
             // Allocate string that will be freed by flow_free_string
-            char* result = new char[json_str.length() + 1];
-            std::strcpy(result, json_str.c_str());
-            return result;
+            return flow_ffi::copy_string(json_str);
 
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -487,7 +479,8 @@ FLOW_FFI_EXPORT FlowError flow_node_load_from_json(FlowNodeHandle node, const ch
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
@@ -495,7 +488,7 @@ FLOW_FFI_EXPORT FlowError flow_node_load_from_json(FlowNodeHandle node, const ch
 
         try {
             json j = json::parse(json_str);
-            node_wrapper->node->Restore(j);
+            target->Restore(j);
             return FLOW_SUCCESS;
 
         } catch (const json::parse_error& e) {
@@ -524,14 +517,15 @@ FLOW_FFI_EXPORT FlowError flow_node_get_input_port_keys(FlowNodeHandle node, cha
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
         try {
-            const auto& input_ports = node_wrapper->node->GetInputPorts();
+            const auto& input_ports = target->GetInputPorts();
             *count = input_ports.size();
 
             if (*count == 0) {
@@ -539,14 +533,12 @@ FLOW_FFI_EXPORT FlowError flow_node_get_input_port_keys(FlowNodeHandle node, cha
                 return FLOW_SUCCESS;
             }
 
-            // Allocate array of char* pointers
-            *port_keys = new char*[*count];
+            // Allocate array of char* pointers; the keys themselves are interned
+            *port_keys = flow_ffi::alloc_array<char*>(*count);
 
             size_t i = 0;
             for (const auto& [key, port] : input_ports) {
-                std::string key_str = std::string(key);
-                (*port_keys)[i] = new char[key_str.length() + 1];
-                std::strcpy((*port_keys)[i], key_str.c_str());
+                (*port_keys)[i] = const_cast<char*>(flow_ffi::intern(key.name()));
                 i++;
             }
 
@@ -570,14 +562,15 @@ FLOW_FFI_EXPORT FlowError flow_node_get_output_port_keys(FlowNodeHandle node, ch
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
         try {
-            const auto& output_ports = node_wrapper->node->GetOutputPorts();
+            const auto& output_ports = target->GetOutputPorts();
             *count = output_ports.size();
 
             if (*count == 0) {
@@ -585,14 +578,12 @@ FLOW_FFI_EXPORT FlowError flow_node_get_output_port_keys(FlowNodeHandle node, ch
                 return FLOW_SUCCESS;
             }
 
-            // Allocate array of char* pointers
-            *port_keys = new char*[*count];
+            // Allocate array of char* pointers; the keys themselves are interned
+            *port_keys = flow_ffi::alloc_array<char*>(*count);
 
             size_t i = 0;
             for (const auto& [key, port] : output_ports) {
-                std::string key_str = std::string(key);
-                (*port_keys)[i] = new char[key_str.length() + 1];
-                std::strcpy((*port_keys)[i], key_str.c_str());
+                (*port_keys)[i] = const_cast<char*>(flow_ffi::intern(key.name()));
                 i++;
             }
 
@@ -620,7 +611,8 @@ FLOW_FFI_EXPORT const char* flow_node_get_input_port_type(FlowNodeHandle node,
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
@@ -628,15 +620,11 @@ FLOW_FFI_EXPORT const char* flow_node_get_input_port_type(FlowNodeHandle node,
 
         try {
             IndexableName port_name(port_key);
-            auto input_port = node_wrapper->node->GetInputPort(port_name);
-            std::string type_str = std::string(input_port->GetDataType());
-
-            // Allocate and copy string - caller must free with flow_free_string
-            char* result = new char[type_str.length() + 1];
-            std::strcpy(result, type_str.c_str());
+            auto input_port = target->GetInputPort(port_name);
 
+            // Interned, owned by the library
             flow_ffi::ErrorManager::instance().clear_error();
-            return result;
+            return flow_ffi::intern(input_port->GetDataType());
 
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -657,7 +645,8 @@ FLOW_FFI_EXPORT const char* flow_node_get_output_port_type(FlowNodeHandle node,
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
@@ -665,15 +654,11 @@ FLOW_FFI_EXPORT const char* flow_node_get_output_port_type(FlowNodeHandle node,
 
         try {
             IndexableName port_name(port_key);
-            auto output_port = node_wrapper->node->GetOutputPort(port_name);
-            std::string type_str = std::string(output_port->GetDataType());
-
-            // Allocate and copy string - caller must free with flow_free_string
-            char* result = new char[type_str.length() + 1];
-            std::strcpy(result, type_str.c_str());
+            auto output_port = target->GetOutputPort(port_name);
 
+            // Interned, owned by the library
             flow_ffi::ErrorManager::instance().clear_error();
-            return result;
+            return flow_ffi::intern(output_port->GetDataType());
 
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -694,7 +679,8 @@ flow_node_get_port_description(FlowNodeHandle node, const char* port_key, bool i
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return nullptr;
@@ -705,16 +691,15 @@ flow_node_get_port_description(FlowNodeHandle node, const char* port_key, bool i
             std::string caption_str;
 
             if (is_input_port) {
-                auto input_port = node_wrapper->node->GetInputPort(port_name);
+                auto input_port = target->GetInputPort(port_name);
                 caption_str = std::string(input_port->GetCaption());
             } else {
-                auto output_port = node_wrapper->node->GetOutputPort(port_name);
+                auto output_port = target->GetOutputPort(port_name);
                 caption_str = std::string(output_port->GetCaption());
             }
 
             // Allocate and copy string - caller must free with flow_free_string
-            char* result = new char[caption_str.length() + 1];
-            std::strcpy(result, caption_str.c_str());
+            char* result = flow_ffi::copy_string(caption_str);
 
             flow_ffi::ErrorManager::instance().clear_error();
             return result;
@@ -789,7 +774,8 @@ FLOW_FFI_EXPORT FlowError flow_node_get_port_metadata(FlowNodeHandle node, const
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
@@ -801,11 +787,11 @@ FLOW_FFI_EXPORT FlowError flow_node_get_port_metadata(FlowNodeHandle node, const
             // Try to get input port first
             SharedPort port = nullptr;
             try {
-                port = node_wrapper->node->GetInputPort(key);
+                port = target->GetInputPort(key);
             } catch (const std::out_of_range&) {
                 // Not an input port, try output
                 try {
-                    port = node_wrapper->node->GetOutputPort(key);
+                    port = target->GetOutputPort(key);
                 } catch (const std::out_of_range&) {
                     flow_ffi::ErrorManager::instance().set_error(
                         FLOW_ERROR_PORT_NOT_FOUND, std::string("Port not found: ") + port_key);
@@ -820,14 +806,11 @@ FLOW_FFI_EXPORT FlowError flow_node_get_port_metadata(FlowNodeHandle node, const
             }
 
             // Allocate and copy the port key
-            char* key_copy = new char[std::strlen(port_key) + 1];
-            std::strcpy(key_copy, port_key);
-            metadata->key = key_copy;
+            metadata->key = flow_ffi::copy_string(port_key);
 
             // Create interworking JSON
             std::string json_str = CreateInterworkingJson(port);
-            char* json_copy = new char[json_str.length() + 1];
-            std::strcpy(json_copy, json_str.c_str());
+            char* json_copy = flow_ffi::copy_string(json_str);
             metadata->interworking_value_json = json_copy;
 
             // Check if port has default data
@@ -858,14 +841,15 @@ FLOW_FFI_EXPORT FlowError flow_node_get_input_ports_metadata(FlowNodeHandle node
         }
 
         auto* node_wrapper = flow_ffi::get_handle<NodeWrapper>(node);
-        if (!node_wrapper) {
+        SharedNode target = node_wrapper ? node_wrapper->get() : nullptr;
+        if (!target) {
             flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
                                                          "Invalid node handle");
             return FLOW_ERROR_INVALID_HANDLE;
         }
 
         try {
-            const auto& input_ports = node_wrapper->node->GetInputPorts();
+            const auto& input_ports = target->GetInputPorts();
             *count = input_ports.size();
 
             if (*count == 0) {
@@ -874,20 +858,18 @@ FLOW_FFI_EXPORT FlowError flow_node_get_input_ports_metadata(FlowNodeHandle node
             }
 
             // Allocate array of metadata structures
-            *metadata_array = new FlowPortMetadata[*count];
+            *metadata_array = flow_ffi::alloc_array<FlowPortMetadata>(*count);
 
             size_t i = 0;
             for (const auto& [key, port] : input_ports) {
                 // Allocate and copy the port key
                 std::string key_str = std::string(key);
-                char* key_copy = new char[key_str.length() + 1];
-                std::strcpy(key_copy, key_str.c_str());
+                char* key_copy = flow_ffi::copy_string(key_str);
                 (*metadata_array)[i].key = key_copy;
 
                 // Create interworking JSON
                 std::string json_str = CreateInterworkingJson(port);
-                char* json_copy = new char[json_str.length() + 1];
-                std::strcpy(json_copy, json_str.c_str());
+                char* json_copy = flow_ffi::copy_string(json_str);
                 (*metadata_array)[i].interworking_value_json = json_copy;
 
                 // Check if port has default data
@@ -913,16 +895,12 @@ FLOW_FFI_EXPORT void flow_free_port_metadata_array(FlowPortMetadata* metadata_ar
 
     // Free each metadata entry's strings
     for (size_t i = 0; i < count; i++) {
-        if (metadata_array[i].key != nullptr) {
-            delete[] metadata_array[i].key;
-        }
-        if (metadata_array[i].interworking_value_json != nullptr) {
-            delete[] metadata_array[i].interworking_value_json;
-        }
+        flow_ffi::free_string(metadata_array[i].key);
+        flow_ffi::free_string(metadata_array[i].interworking_value_json);
     }
 
     // Free the array itself
-    delete[] metadata_array;
+    flow_ffi::free_array(metadata_array);
 }
 
 FLOW_FFI_EXPORT void flow_free_port_metadata(FlowPortMetadata* metadata) {
@@ -931,14 +909,10 @@ FLOW_FFI_EXPORT void flow_free_port_metadata(FlowPortMetadata* metadata) {
     }
 
     // Free the strings within the metadata structure
-    if (metadata->key != nullptr) {
-        delete[] metadata->key;
-        metadata->key = nullptr;
-    }
-    if (metadata->interworking_value_json != nullptr) {
-        delete[] metadata->interworking_value_json;
-        metadata->interworking_value_json = nullptr;
-    }
+    flow_ffi::free_string(metadata->key);
+    metadata->key = nullptr;
+    flow_ffi::free_string(metadata->interworking_value_json);
+    metadata->interworking_value_json = nullptr;
 
     // Note: We don't delete the metadata structure itself
     // because it's typically allocated on the stack by the caller
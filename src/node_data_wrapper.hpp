@@ -0,0 +1,13 @@
+#pragma once
+
+#include <flow/core/NodeData.hpp>
+
+#include <memory>
+
+// Wrapper structure for NodeData handles, shared by all bridges
+
+struct NodeDataWrapper {
+    flow::SharedNodeData data;
+
+    NodeDataWrapper(flow::SharedNodeData d) : data(std::move(d)) {}
+};
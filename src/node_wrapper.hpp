@@ -0,0 +1,60 @@
+#pragma once
+
+#include <flow/core/Node.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "string_interner.hpp"
+
+// Wrapper structure for Node handles, shared by all bridges. The node may be swapped
+// for a new instance when its module is reloaded, and is null if its class is gone, so
+// it is only read and swapped under the wrapper's lock.
+
+struct NodeWrapper {
+    NodeWrapper(flow::SharedNode n)
+        : node_(std::move(n)), id(node_ ? std::string(node_->ID()) : std::string()) {}
+
+    NodeWrapper(const NodeWrapper& other) : node_(other.get()), id(other.id) {}
+    NodeWrapper& operator=(const NodeWrapper&) = delete;
+
+    flow::SharedNode get() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return node_;
+    }
+
+    // The previous node is released after the lock
+    void set(flow::SharedNode node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        node_.swap(node);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    flow::SharedNode node_;
+
+public:
+    flow_ffi::BorrowedString id; // Formatted once, returned by flow_node_get_id
+};
+
+namespace flow_ffi {
+
+// Node handles given to graph event callbacks hold a bare SharedNode, which a reload
+// swaps as well; it is only read and written through these
+inline std::mutex& shared_node_handle_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline flow::SharedNode load_node(const flow::SharedNode& slot) {
+    std::lock_guard<std::mutex> lock(shared_node_handle_mutex());
+    return slot;
+}
+
+inline void store_node(flow::SharedNode& slot, flow::SharedNode node) {
+    std::lock_guard<std::mutex> lock(shared_node_handle_mutex());
+    slot.swap(node);
+}
+
+} // namespace flow_ffi
@@ -0,0 +1,383 @@
+#include "output_cache.hpp"
+
+#include <flow/core/Env.hpp>
+#include <flow/core/NodeFactory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "module_wrapper.hpp"
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+
+using namespace flow;
+
+namespace flow_ffi {
+
+namespace {
+
+constexpr char kEntryMagic[4] = {'F', 'L', 'O', 'C'};
+constexpr uint32_t kEntryVersion = 2;
+constexpr const char* kEntryExtension = ".out";
+
+enum ValueTag : uint8_t { kNone = 0, kInt = 1, kDouble = 2, kBool = 3, kString = 4 };
+
+template <typename T> void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put_string(std::string& out, const std::string& str) {
+    put<uint64_t>(out, str.size());
+    out += str;
+}
+
+// false if data has a type the cache cannot store
+bool encode(const SharedNodeData& data, std::string& out) {
+    if (!data) {
+        put<uint8_t>(out, kNone);
+        return true;
+    }
+
+    const auto type = data->Type();
+    if (type == TypeName_v<int>) {
+        put<uint8_t>(out, kInt);
+        put<int64_t>(out, static_cast<detail::NodeData<int>*>(data.get())->Get());
+    } else if (type == TypeName_v<double>) {
+        put<uint8_t>(out, kDouble);
+        put<double>(out, static_cast<detail::NodeData<double>*>(data.get())->Get());
+    } else if (type == TypeName_v<bool>) {
+        put<uint8_t>(out, kBool);
+        put<uint8_t>(out, static_cast<detail::NodeData<bool>*>(data.get())->Get() ? 1 : 0);
+    } else if (type == TypeName_v<std::string>) {
+        put<uint8_t>(out, kString);
+        put_string(out, static_cast<detail::NodeData<std::string>*>(data.get())->Get());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Bounds-checked view of an entry file
+class Reader {
+public:
+    explicit Reader(const std::string& bytes)
+        : pos_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+    template <typename T> bool get(T& value) {
+        if (static_cast<std::size_t>(end_ - pos_) < sizeof(value)) {
+            return false;
+        }
+        std::memcpy(&value, pos_, sizeof(value));
+        pos_ += sizeof(value);
+        return true;
+    }
+
+    bool get_string(std::string& str) {
+        uint64_t size = 0;
+        if (!get(size) || static_cast<uint64_t>(end_ - pos_) < size) {
+            return false;
+        }
+        str.assign(pos_, static_cast<std::size_t>(size));
+        pos_ += size;
+        return true;
+    }
+
+    bool done() const { return pos_ == end_; }
+
+private:
+    const char* pos_;
+    const char* end_;
+};
+
+bool decode(Reader& reader, SharedNodeData& data) {
+    uint8_t tag = 0;
+    if (!reader.get(tag)) {
+        return false;
+    }
+
+    switch (tag) {
+    case kNone:
+        data = nullptr;
+        return true;
+    case kInt: {
+        int64_t value = 0;
+        if (!reader.get(value)) {
+            return false;
+        }
+        data = std::make_shared<detail::NodeData<int>>(static_cast<int>(value));
+        return true;
+    }
+    case kDouble: {
+        double value = 0;
+        if (!reader.get(value)) {
+            return false;
+        }
+        data = std::make_shared<detail::NodeData<double>>(value);
+        return true;
+    }
+    case kBool: {
+        uint8_t value = 0;
+        if (!reader.get(value)) {
+            return false;
+        }
+        data = std::make_shared<detail::NodeData<bool>>(value != 0);
+        return true;
+    }
+    case kString: {
+        std::string value;
+        if (!reader.get_string(value)) {
+            return false;
+        }
+        data = std::make_shared<detail::NodeData<std::string>>(std::move(value));
+        return true;
+    }
+    }
+    return false;
+}
+
+// Port values in port order, so equal maps encode to equal bytes
+bool encode_ports(const OutputCache::PortValues& values, std::string& out) {
+    std::map<std::string, const SharedNodeData*> sorted;
+    for (const auto& [port, data] : values) {
+        sorted.emplace(port, &data);
+    }
+
+    put<uint32_t>(out, static_cast<uint32_t>(sorted.size()));
+    for (const auto& [port, data] : sorted) {
+        put_string(out, port);
+        if (!encode(*data, out)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// FNV-1a; run with two offset bases for a 128-bit file name. Entries are matched on the
+// full key material, so a collision only costs a miss.
+uint64_t fnv1a(const std::string& bytes, uint64_t hash) {
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void append_hex(std::string& out, uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    for (int shift = 60; shift >= 0; shift -= 4) {
+        out.push_back(digits[(value >> shift) & 0xf]);
+    }
+}
+
+} // namespace
+
+std::shared_ptr<OutputCache> OutputCache::open(const fs::path& directory, uint64_t max_bytes) {
+    static std::mutex caches_mutex;
+    static std::map<fs::path, std::weak_ptr<OutputCache>> caches;
+
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    fs::path canonical = fs::weakly_canonical(directory, ec);
+    if (ec || !fs::is_directory(canonical, ec)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(caches_mutex);
+    auto cache = caches[canonical].lock();
+    if (!cache) {
+        cache.reset(new OutputCache(canonical, max_bytes));
+        caches[canonical] = cache;
+        return cache;
+    }
+
+    std::lock_guard<std::mutex> cache_lock(cache->mutex_);
+    cache->max_bytes_ = max_bytes;
+    if (max_bytes > 0 && cache->bytes_ > max_bytes) {
+        cache->evict();
+    }
+    return cache;
+}
+
+OutputCache::OutputCache(fs::path directory, uint64_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict(); // Also measures what other processes left
+}
+
+bool OutputCache::make_key(const Node& node, const PortValues& inputs, Key& key) {
+    std::string material = node.GetClass();
+    material.push_back('\0');
+    if (const auto& env = node.GetEnv()) {
+        if (const auto& factory = env->GetFactory()) {
+            material += node_class_build_id(factory.get(), node.GetClass());
+        }
+    }
+    material.push_back('\0');
+    try {
+        // The same configuration in another graph has another id and maybe another name
+        auto state = node.Save();
+        if (state.is_object()) {
+            state.erase("id");
+            state.erase("name");
+        }
+        material += state.dump();
+    } catch (const std::exception&) {
+        return false;
+    }
+    material.push_back('\0');
+    if (!encode_ports(inputs, material)) {
+        return false;
+    }
+
+    key.hash.clear();
+    append_hex(key.hash, fnv1a(material, 0xcbf29ce484222325ULL));
+    append_hex(key.hash, fnv1a(material, 0x84222325cbf29ce4ULL));
+    key.material = std::move(material);
+    return true;
+}
+
+fs::path OutputCache::entry_path(const Key& key) const {
+    return directory_ / (key.hash + kEntryExtension);
+}
+
+bool OutputCache::find(const Key& key, PortValues& outputs) {
+    const fs::path path = entry_path(key);
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    Reader reader(bytes);
+    char magic[sizeof(kEntryMagic)] = {};
+    uint32_t version = 0;
+    std::string material;
+    uint32_t count = 0;
+    bool valid = reader.get(magic) && std::memcmp(magic, kEntryMagic, sizeof(magic)) == 0 &&
+                 reader.get(version) && version == kEntryVersion &&
+                 reader.get_string(material);
+    if (valid && material != key.material) {
+        return false; // Another key with the same hash
+    }
+    valid = valid && reader.get(count);
+    PortValues values;
+    for (uint32_t i = 0; valid && i < count; ++i) {
+        std::string port;
+        SharedNodeData data;
+        valid = reader.get_string(port) && decode(reader, data);
+        if (valid && data) {
+            values.emplace(std::move(port), std::move(data));
+        }
+    }
+
+    std::error_code ec;
+    if (!valid || !reader.done()) {
+        fs::remove(path, ec);
+        return false;
+    }
+
+    // Marks the entry as recently used for every process sharing the directory
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    outputs = std::move(values);
+    return true;
+}
+
+bool OutputCache::store(const Key& key, const PortValues& outputs) {
+    std::string bytes(kEntryMagic, sizeof(kEntryMagic));
+    put<uint32_t>(bytes, kEntryVersion);
+    put_string(bytes, key.material);
+    if (!encode_ports(outputs, bytes)) {
+        return false;
+    }
+
+    // Readers in other processes must never observe a partially written entry
+    static std::atomic<uint64_t> counter{0};
+    const fs::path path = entry_path(key);
+    fs::path tmp_path = path;
+    tmp_path += ".tmp" +
+                std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+                std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                "." + std::to_string(counter++);
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            file.close();
+            std::error_code ec;
+            fs::remove(tmp_path, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmp_path, path, ec);
+    if (ec) {
+        fs::remove(tmp_path, ec);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_ += bytes.size();
+    if (max_bytes_ > 0 && bytes_ > max_bytes_) {
+        evict();
+    }
+    return true;
+}
+
+void OutputCache::evict() {
+    struct Entry {
+        fs::file_time_type used;
+        uint64_t size;
+        fs::path path;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entry_ec;
+        if (it->path().extension() != kEntryExtension || !it->is_regular_file(entry_ec)) {
+            continue;
+        }
+        Entry entry{it->last_write_time(entry_ec), it->file_size(entry_ec), it->path()};
+        if (!entry_ec) {
+            total += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    // Down to a low-water mark, so a full cache is not rescanned on every store
+    const uint64_t target = max_bytes_ - max_bytes_ / 10;
+    if (max_bytes_ > 0 && total > target) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.used < b.used; });
+        for (const auto& entry : entries) {
+            if (total <= target) {
+                break;
+            }
+            std::error_code remove_ec;
+            fs::remove(entry.path, remove_ec); // Gone already if another process evicted it
+            if (!remove_ec) {
+                total -= entry.size;
+            }
+        }
+    }
+    bytes_ = total;
+}
+
+} // namespace flow_ffi
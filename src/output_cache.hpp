@@ -0,0 +1,66 @@
+#pragma once
+
+#include <flow/core/Node.hpp>
+#include <flow/core/NodeData.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace flow_ffi {
+
+// On-disk cache of node outputs, shared across graphs and processes.
+//
+// An entry is keyed by the node's class and the build of the module providing it, the
+// node's saved state without its identity and its input values, so identical nodes
+// computing identical inputs hit the same entry in any graph. A hash of that key names
+// the entry's file and the entry stores the key itself, so a hash collision is a miss
+// rather than another node's outputs. Only int, double, bool and string values can be
+// keyed and stored; nodes with other inputs or outputs are computed as usual. Entries
+// are files in one directory, written atomically, and their modification time is the
+// LRU clock every process shares.
+class OutputCache {
+public:
+    using PortValues = std::unordered_map<std::string, flow::SharedNodeData>;
+
+    // The process-wide cache of directory, created on first use. max_bytes (0 for no
+    // limit) applies from then on to every user of the directory in this process.
+    static std::shared_ptr<OutputCache> open(const std::filesystem::path& directory,
+                                             uint64_t max_bytes);
+
+    struct Key {
+        std::string hash;     // Names the entry file
+        std::string material; // What was hashed, compared on every find
+    };
+
+    // false if node or one of the inputs cannot be keyed
+    static bool make_key(const flow::Node& node, const PortValues& inputs, Key& key);
+
+    // Outputs stored under key; false on a miss or an unreadable entry
+    bool find(const Key& key, PortValues& outputs);
+
+    // false if an output cannot be stored or the entry could not be written
+    bool store(const Key& key, const PortValues& outputs);
+
+    const std::filesystem::path& directory() const { return directory_; }
+
+private:
+    OutputCache(std::filesystem::path directory, uint64_t max_bytes);
+
+    std::filesystem::path entry_path(const Key& key) const;
+
+    // Deletes the least recently used entries of every process until the directory is
+    // back under 90% of the limit. Called with mutex_ held.
+    void evict();
+
+    std::filesystem::path directory_;
+
+    std::mutex mutex_;
+    uint64_t max_bytes_ = 0;
+    uint64_t bytes_ = 0; // Directory size as of the last scan plus what this process wrote
+};
+
+} // namespace flow_ffi
@@ -0,0 +1,262 @@
+#include "result_memory.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "string_interner.hpp"
+
+namespace flow_ffi {
+
+namespace {
+
+constexpr std::size_t kArenaBlockSize = 64 * 1024;
+
+struct Allocator {
+    FlowAllocFn alloc_fn;
+    FlowFreeFn free_fn;
+    void* user_data;
+};
+
+// Matches the new char[] / new T[] allocations callers have always released with flow_free_*
+void* default_alloc(size_t size, void*) {
+    return ::operator new[](size, std::nothrow);
+}
+
+void default_free(void* ptr, void*) {
+    ::operator delete[](ptr);
+}
+
+// Installed allocators are immutable and kept for the life of the process, so readers
+// need no lock
+const Allocator g_default_allocator{default_alloc, default_free, nullptr};
+std::atomic<const Allocator*> g_allocator{&g_default_allocator};
+std::mutex g_installed_mutex;
+std::list<Allocator> g_installed;
+
+// Allocator of every heap result, so flow_free_* releases it with the free function it
+// came from after a switch. Results freed directly with free_fn leave a stale entry,
+// which is overwritten when the address is handed out again.
+std::mutex g_results_mutex;
+std::unordered_map<const void*, const Allocator*> g_results;
+
+// Prefix of internal allocations; padded so the payload keeps malloc alignment
+struct alignas(alignof(std::max_align_t)) InternalHeader {
+    FlowFreeFn free_fn;
+    void* user_data;
+};
+
+// Address ranges of all arena blocks, so frees from any thread can recognize them
+std::shared_mutex g_blocks_mutex;
+std::map<const std::byte*, const std::byte*> g_blocks;
+std::atomic<std::size_t> g_block_count{0};
+
+struct InternalDeleter {
+    void operator()(std::byte* ptr) const noexcept { free_internal(ptr); }
+};
+
+void register_block(const std::byte* begin, std::size_t size) {
+    std::unique_lock<std::shared_mutex> lock(g_blocks_mutex);
+    g_blocks.emplace(begin, begin + size);
+    g_block_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void unregister_block(const std::byte* begin) {
+    std::unique_lock<std::shared_mutex> lock(g_blocks_mutex);
+    g_blocks.erase(begin);
+    g_block_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+class ResultArena {
+public:
+    ~ResultArena() {
+        for (const auto& block : blocks_) {
+            unregister_block(block.data.get());
+        }
+    }
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        size = size == 0 ? 1 : size;
+        while (block_ < blocks_.size()) {
+            auto& block = blocks_[block_];
+            std::size_t start = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (start + size <= block.size) {
+                offset_ = start + size;
+                used_ += size;
+                return block.data.get() + start;
+            }
+            ++block_;
+            offset_ = 0;
+        }
+
+        // Internal allocations are aligned for any fundamental type
+        std::size_t block_size = size > kArenaBlockSize ? size : kArenaBlockSize;
+        auto* data = static_cast<std::byte*>(allocate_internal(block_size));
+        blocks_.push_back({std::unique_ptr<std::byte, InternalDeleter>(data), block_size});
+        register_block(blocks_.back().data.get(), block_size);
+        block_ = blocks_.size() - 1;
+        offset_ = size;
+        used_ += size;
+        return blocks_.back().data.get();
+    }
+
+    void reset() {
+        // Keep standard blocks for reuse, drop oversized ones
+        std::vector<Block> kept;
+        for (auto& block : blocks_) {
+            if (block.size == kArenaBlockSize) {
+                kept.push_back(std::move(block));
+            } else {
+                unregister_block(block.data.get());
+            }
+        }
+        blocks_ = std::move(kept);
+        block_ = 0;
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    std::size_t bytes_used() const { return used_; }
+
+    bool enabled = false;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte, InternalDeleter> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    std::size_t block_ = 0;
+    std::size_t offset_ = 0;
+    std::size_t used_ = 0;
+};
+
+ResultArena& thread_arena() {
+    thread_local ResultArena arena;
+    return arena;
+}
+
+} // namespace
+
+void set_allocator(FlowAllocFn alloc_fn, FlowFreeFn free_fn, void* user_data) {
+    if (!alloc_fn) {
+        g_allocator.store(&g_default_allocator, std::memory_order_release);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_installed_mutex);
+    g_installed.push_back({alloc_fn, free_fn, user_data});
+    g_allocator.store(&g_installed.back(), std::memory_order_release);
+}
+
+void* allocate_result(std::size_t size) {
+    const Allocator* allocator = g_allocator.load(std::memory_order_acquire);
+    void* ptr = allocator->alloc_fn(size == 0 ? 1 : size, allocator->user_data);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    try {
+        std::lock_guard<std::mutex> lock(g_results_mutex);
+        g_results.insert_or_assign(ptr, allocator);
+    } catch (...) {
+        allocator->free_fn(ptr, allocator->user_data);
+        throw;
+    }
+    return ptr;
+}
+
+void free_result(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    const Allocator* allocator = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_results_mutex);
+        auto it = g_results.find(ptr);
+        if (it != g_results.end()) {
+            allocator = it->second;
+            g_results.erase(it);
+        }
+    }
+    if (!allocator) {
+        allocator = g_allocator.load(std::memory_order_acquire);
+    }
+    allocator->free_fn(ptr, allocator->user_data);
+}
+
+void* allocate_internal(std::size_t size) {
+    const Allocator* allocator = g_allocator.load(std::memory_order_acquire);
+    void* ptr = allocator->alloc_fn(sizeof(InternalHeader) + size, allocator->user_data);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    auto* header = new (ptr) InternalHeader{allocator->free_fn, allocator->user_data};
+    return header + 1;
+}
+
+void free_internal(void* ptr) noexcept {
+    if (ptr) {
+        auto* header = static_cast<InternalHeader*>(ptr) - 1;
+        header->free_fn(header, header->user_data);
+    }
+}
+
+void* arena_allocate(std::size_t size, std::size_t alignment) {
+    auto& arena = thread_arena();
+    return arena.enabled ? arena.allocate(size, alignment) : nullptr;
+}
+
+bool is_arena_memory(const void* ptr) {
+    if (!ptr || g_block_count.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    auto* address = static_cast<const std::byte*>(ptr);
+    std::shared_lock<std::shared_mutex> lock(g_blocks_mutex);
+    auto it = g_blocks.upper_bound(address);
+    if (it == g_blocks.begin()) {
+        return false;
+    }
+    --it;
+    return address < it->second;
+}
+
+char* copy_string(std::string_view str) {
+    char* result = alloc_array<char>(str.size() + 1);
+    std::memcpy(result, str.data(), str.size());
+    result[str.size()] = '\0';
+    return result;
+}
+
+void free_string(const char* str) {
+    if (!str || is_arena_memory(str) || StringInterner::instance().is_library_owned(str)) {
+        return;
+    }
+    free_result(const_cast<char*>(str));
+}
+
+void set_result_arena_enabled(bool enabled) {
+    thread_arena().enabled = enabled;
+}
+
+bool result_arena_enabled() {
+    return thread_arena().enabled;
+}
+
+void reset_result_arena() {
+    thread_arena().reset();
+}
+
+std::size_t result_arena_bytes_used() {
+    return thread_arena().bytes_used();
+}
+
+} // namespace flow_ffi
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#include "flow_ffi.h"
+
+namespace flow_ffi {
+
+// Memory handed out to FFI callers (strings, arrays, result structs). By default every
+// result is a separate heap allocation released by the matching flow_free_* function.
+// A thread can opt into a result arena instead: results are bump-allocated and released
+// in bulk by flow_result_arena_reset, and the flow_free_* functions skip them.
+// Heap results come from the allocator installed with flow_set_allocator (new[]/delete[]
+// by default) without any header, so callers may release them with free_fn directly.
+// Their allocator is recorded on the side, and free_result uses it even after a switch.
+
+// Installs allocator hooks; null for both restores the default
+void set_allocator(FlowAllocFn alloc_fn, FlowFreeFn free_fn, void* user_data);
+
+// Result buffer from the current allocator; throws std::bad_alloc on failure
+void* allocate_result(std::size_t size);
+void free_result(void* ptr);
+
+// Internal allocation that records its allocator, so it can be freed after a switch
+void* allocate_internal(std::size_t size);
+void free_internal(void* ptr) noexcept;
+
+// Returns arena memory if the calling thread has the arena enabled, nullptr otherwise
+void* arena_allocate(std::size_t size, std::size_t alignment);
+
+// True if ptr points into any thread's result arena
+bool is_arena_memory(const void* ptr);
+
+// Null-terminated copy of str
+char* copy_string(std::string_view str);
+
+// Value-initialized array of count elements
+template <typename T>
+T* alloc_array(std::size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>, "Result arrays must be trivial");
+    if (void* memory = arena_allocate(sizeof(T) * count, alignof(T))) {
+        auto* array = static_cast<T*>(memory);
+        std::uninitialized_value_construct_n(array, count);
+        return array;
+    }
+    auto* array = static_cast<T*>(allocate_result(sizeof(T) * count));
+    std::uninitialized_value_construct_n(array, count);
+    return array;
+}
+
+// Releases a string from copy_string; ignores null, arena and library-owned strings
+void free_string(const char* str);
+
+// Releases an array from alloc_array; ignores null and arena arrays
+template <typename T>
+void free_array(T* array) {
+    if (array && !is_arena_memory(array)) {
+        free_result(const_cast<std::remove_cv_t<T>*>(array));
+    }
+}
+
+// Per-thread arena control, backing the flow_result_arena_* API
+void set_result_arena_enabled(bool enabled);
+bool result_arena_enabled();
+void reset_result_arena();
+std::size_t result_arena_bytes_used();
+
+} // namespace flow_ffi
@@ -0,0 +1,45 @@
+#include "string_interner.hpp"
+
+#include <mutex>
+
+namespace flow_ffi {
+
+const char* StringInterner::intern(std::string_view str) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = strings_.find(str);
+        if (it != strings_.end()) {
+            return it->c_str();
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Set nodes never move, so the character data stays put across rehashes
+    auto [it, inserted] = strings_.emplace(str);
+    if (inserted) {
+        owned_.insert(it->c_str());
+    }
+    return it->c_str();
+}
+
+void StringInterner::add_borrowed(const char* str) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    owned_.insert(str);
+}
+
+void StringInterner::remove_borrowed(const char* str) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    owned_.erase(str);
+}
+
+bool StringInterner::is_library_owned(const void* str) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return owned_.count(str) > 0;
+}
+
+std::size_t StringInterner::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return strings_.size();
+}
+
+} // namespace flow_ffi
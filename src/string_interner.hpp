@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace flow_ffi {
+
+// Process-wide table of immutable strings (class names, port keys, type names).
+// Interned pointers stay valid for the lifetime of the process, so getters can hand
+// them out without a copy. flow_free_string ignores every library-owned pointer, which
+// keeps callers that still free these results working.
+class StringInterner {
+public:
+    static StringInterner& instance() {
+        static StringInterner interner;
+        return interner;
+    }
+
+    const char* intern(std::string_view str);
+
+    // Strings owned by a handle (e.g. a cached node id) that callers must not free
+    void add_borrowed(const char* str);
+    void remove_borrowed(const char* str);
+
+    bool is_library_owned(const void* str) const;
+
+    std::size_t size() const;
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view str) const {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    StringInterner() = default;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_set<std::string, Hash, std::equal_to<>> strings_;
+    std::unordered_set<const void*> owned_;
+};
+
+inline const char* intern(std::string_view str) {
+    return StringInterner::instance().intern(str);
+}
+
+// A string stored on a handle and lent out by getters; valid until the handle is released
+class BorrowedString {
+public:
+    BorrowedString() { StringInterner::instance().add_borrowed(value_.c_str()); }
+    explicit BorrowedString(std::string value) : value_(std::move(value)) {
+        StringInterner::instance().add_borrowed(value_.c_str());
+    }
+    BorrowedString(const BorrowedString& other) : BorrowedString(other.value_) {}
+    BorrowedString& operator=(const BorrowedString& other) {
+        if (this != &other) {
+            StringInterner::instance().remove_borrowed(value_.c_str());
+            value_ = other.value_;
+            StringInterner::instance().add_borrowed(value_.c_str());
+        }
+        return *this;
+    }
+    ~BorrowedString() { StringInterner::instance().remove_borrowed(value_.c_str()); }
+
+    const char* c_str() const { return value_.c_str(); }
+    const std::string& str() const { return value_; }
+
+private:
+    std::string value_;
+};
+
+} // namespace flow_ffi
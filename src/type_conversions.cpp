@@ -2,19 +2,15 @@
 
 #include <flow/core/NodeData.hpp>
 
-#include <cstring>
-
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "node_data_wrapper.hpp"
+#include "memory_usage.hpp"
+#include "result_memory.hpp"
+#include "string_interner.hpp"
 
 using namespace flow;
 
-// Wrapper structure for NodeData (forward declaration in node_bridge.cpp)
-struct NodeDataWrapper {
-    SharedNodeData data;
-    NodeDataWrapper(SharedNodeData d) : data(std::move(d)) {}
-};
-
 // Helper function to create typed NodeData
 template <typename T>
 SharedNodeData CreateTypedData(const T& value) {
@@ -233,8 +229,7 @@ FLOW_FFI_EXPORT FlowError flow_data_get_string(FlowNodeDataHandle data, char** v
             const std::string& str_value = typed_data->Get();
 
             // Allocate string that will be freed by flow_free_string
-            *value = new char[str_value.length() + 1];
-            std::strcpy(*value, str_value.c_str());
+            *value = flow_ffi::copy_string(str_value);
             return FLOW_SUCCESS;
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
@@ -264,14 +259,8 @@ FLOW_FFI_EXPORT const char* flow_data_get_type(FlowNodeDataHandle data) {
         }
 
         try {
-            std::string_view type_name = data_wrapper->data->Type();
-
-            // Allocate string that will be freed by flow_free_string
-            // Convert string_view to string to ensure null-termination
-            std::string type_str(type_name);
-            char* result = new char[type_str.length() + 1];
-            std::strcpy(result, type_str.c_str());
-            return result;
+            // Interned (null-terminated copy of the type name), owned by the library
+            return flow_ffi::intern(data_wrapper->data->Type());
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
                 FLOW_ERROR_UNKNOWN, std::string("Failed to get data type: ") + e.what());
@@ -314,9 +303,7 @@ FLOW_FFI_EXPORT const char* flow_data_to_string(FlowNodeDataHandle data) {
             std::string str_value = data_wrapper->data->ToString();
 
             // Allocate string that will be freed by flow_free_string
-            char* result = new char[str_value.length() + 1];
-            std::strcpy(result, str_value.c_str());
-            return result;
+            return flow_ffi::copy_string(str_value);
         } catch (const std::exception& e) {
             flow_ffi::ErrorManager::instance().set_error(
                 FLOW_ERROR_UNKNOWN, std::string("Failed to convert data to string: ") + e.what());
@@ -325,4 +312,32 @@ FLOW_FFI_EXPORT const char* flow_data_to_string(FlowNodeDataHandle data) {
     });
 }
 
+FLOW_FFI_EXPORT size_t flow_data_get_memory_size(FlowNodeDataHandle data) {
+    if (!flow_ffi::validate_handle(data, "data")) {
+        return 0;
+    }
+
+    auto* data_wrapper = flow_ffi::get_handle<NodeDataWrapper>(data);
+    if (!data_wrapper || !data_wrapper->data) {
+        flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_HANDLE,
+                                                     "Invalid data handle");
+        return 0;
+    }
+
+    try {
+        auto bytes = flow_ffi::node_data_bytes(*data_wrapper->data);
+        if (!bytes) {
+            flow_ffi::ErrorManager::instance().set_error(
+                FLOW_ERROR_NOT_IMPLEMENTED,
+                "No size estimate for type: " + std::string(data_wrapper->data->Type()));
+            return 0;
+        }
+        return *bytes;
+    } catch (const std::exception& e) {
+        flow_ffi::ErrorManager::instance().set_error(
+            FLOW_ERROR_UNKNOWN, std::string("Failed to measure data: ") + e.what());
+        return 0;
+    }
+}
+
 } // extern "C"
\ No newline at end of file
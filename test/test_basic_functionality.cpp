@@ -1,7 +1,14 @@
 #include "flow_ffi.h"
 
+#include <cstdlib>
 #include <cstring>
+#include <new>
+#include <string>
+#include <thread>
 
+#include "handle_manager.hpp"
+#include "result_memory.hpp"
+#include "string_interner.hpp"
 #include <gtest/gtest.h>
 
 class BasicFunctionalityTest : public ::testing::Test {
@@ -25,6 +32,149 @@ TEST_F(BasicFunctionalityTest, MemoryManagementHelpers) {
     EXPECT_EQ(flow_get_last_error(), nullptr);
 }
 
+TEST_F(BasicFunctionalityTest, InternedStringsAreStableAndNotFreed) {
+    const char* a = flow_ffi::intern("Float");
+    const char* b = flow_ffi::intern(std::string("Fl") + "oat");
+    EXPECT_EQ(a, b);
+    EXPECT_STREQ(a, "Float");
+    EXPECT_NE(flow_ffi::intern("Integer"), a);
+    EXPECT_TRUE(flow_ffi::StringInterner::instance().is_library_owned(a));
+
+    // Freeing a library-owned string must leave it intact
+    flow_free_string(const_cast<char*>(a));
+    EXPECT_STREQ(flow_ffi::intern("Float"), "Float");
+
+    char* copy = new char[4];
+    std::strcpy(copy, "abc");
+    EXPECT_FALSE(flow_ffi::StringInterner::instance().is_library_owned(copy));
+    flow_free_string(copy);
+}
+
+TEST_F(BasicFunctionalityTest, BorrowedStringsAreOwnedUntilDestroyed) {
+    const char* ptr = nullptr;
+    {
+        flow_ffi::BorrowedString id(std::string("0123456789abcdef0123456789abcdef"));
+        flow_ffi::BorrowedString copy = id;
+        ptr = id.c_str();
+        EXPECT_TRUE(flow_ffi::StringInterner::instance().is_library_owned(ptr));
+        EXPECT_TRUE(flow_ffi::StringInterner::instance().is_library_owned(copy.c_str()));
+        EXPECT_NE(copy.c_str(), ptr);
+
+        flow_free_string(const_cast<char*>(ptr)); // No-op
+        EXPECT_EQ(id.str(), "0123456789abcdef0123456789abcdef");
+    }
+    EXPECT_FALSE(flow_ffi::StringInterner::instance().is_library_owned(ptr));
+}
+
+TEST_F(BasicFunctionalityTest, ResultArenaBulkReleasesResults) {
+    EXPECT_FALSE(flow_result_arena_is_enabled());
+    char* heap = flow_ffi::copy_string("heap");
+    EXPECT_FALSE(flow_ffi::is_arena_memory(heap));
+    flow_free_string(heap);
+
+    flow_result_arena_enable(true);
+    EXPECT_TRUE(flow_result_arena_is_enabled());
+
+    char* str = flow_ffi::copy_string("arena string");
+    EXPECT_STREQ(str, "arena string");
+    EXPECT_TRUE(flow_ffi::is_arena_memory(str));
+
+    char** array = flow_ffi::alloc_array<char*>(3);
+    EXPECT_TRUE(flow_ffi::is_arena_memory(array));
+    EXPECT_EQ(array[0], nullptr);
+    array[0] = flow_ffi::copy_string("a");
+    array[1] = flow_ffi::copy_string("b");
+    EXPECT_GT(flow_result_arena_bytes_used(), 0u);
+
+    // Frees are no-ops for arena memory, from this thread or any other
+    flow_free_string(str);
+    flow_free_string_array(array, 3);
+    std::thread([str] { flow_free_string(str); }).join();
+    EXPECT_STREQ(str, "arena string");
+
+    // Oversized results get their own block
+    std::string large(200 * 1024, 'x');
+    char* big = flow_ffi::copy_string(large);
+    EXPECT_TRUE(flow_ffi::is_arena_memory(big));
+    EXPECT_EQ(std::strlen(big), large.size());
+
+    flow_result_arena_reset();
+    EXPECT_EQ(flow_result_arena_bytes_used(), 0u);
+    EXPECT_FALSE(flow_ffi::is_arena_memory(big));
+
+    // Other threads keep using the heap
+    std::thread([] {
+        EXPECT_FALSE(flow_result_arena_is_enabled());
+        char* other = flow_ffi::copy_string("other");
+        EXPECT_FALSE(flow_ffi::is_arena_memory(other));
+        flow_free_string(other);
+    }).join();
+
+    flow_result_arena_enable(false);
+    heap = flow_ffi::copy_string("heap again");
+    EXPECT_FALSE(flow_ffi::is_arena_memory(heap));
+    flow_free_string(heap);
+}
+
+namespace {
+
+struct CountingAllocator {
+    int live = 0;
+    int total = 0;
+    bool fail = false;
+};
+
+void* counting_alloc(size_t size, void* user_data) {
+    auto* counter = static_cast<CountingAllocator*>(user_data);
+    if (counter->fail) {
+        return nullptr;
+    }
+    ++counter->live;
+    ++counter->total;
+    return std::malloc(size);
+}
+
+void counting_free(void* ptr, void* user_data) {
+    --static_cast<CountingAllocator*>(user_data)->live;
+    std::free(ptr);
+}
+
+} // namespace
+
+TEST_F(BasicFunctionalityTest, AllocatorHooksServeResultsAndHandles) {
+    EXPECT_EQ(flow_set_allocator(counting_alloc, nullptr, nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+
+    CountingAllocator counter;
+    ASSERT_EQ(flow_set_allocator(counting_alloc, counting_free, &counter), FLOW_SUCCESS);
+
+    char* str = flow_ffi::copy_string("hooked");
+    char** array = flow_ffi::alloc_array<char*>(2);
+    array[0] = flow_ffi::copy_string("a");
+    void* handle = flow_ffi::create_handle<int>(42);
+    EXPECT_EQ(counter.live, 4);
+
+    // Results can go back through the library or straight to the caller's free function
+    flow_free_string_array(array, 2);
+    counting_free(str, &counter);
+    EXPECT_EQ(counter.live, 1);
+
+    counter.fail = true;
+    EXPECT_THROW(flow_ffi::copy_string("no memory"), std::bad_alloc);
+    counter.fail = false;
+
+    // Handles and results remember their allocator and are freed by it after a switch
+    char* kept = flow_ffi::copy_string("kept");
+    EXPECT_EQ(counter.live, 2);
+    ASSERT_EQ(flow_set_allocator(nullptr, nullptr, nullptr), FLOW_SUCCESS);
+    EXPECT_TRUE(flow_ffi::release_handle(handle));
+    flow_free_string(kept);
+    EXPECT_EQ(counter.live, 0);
+
+    int total = counter.total;
+    flow_free_string(flow_ffi::copy_string("default"));
+    EXPECT_EQ(counter.total, total);
+}
+
 // NOTE: This test is now obsolete as all phases have been implemented
 // All functions that were previously placeholders are now fully functional
 // Keeping this disabled for historical reference
@@ -46,6 +196,7 @@ TEST_F(BasicFunctionalityTest, ErrorCodesEnumValues) {
     EXPECT_EQ(FLOW_ERROR_OUT_OF_MEMORY, -8);
     EXPECT_EQ(FLOW_ERROR_TYPE_MISMATCH, -9);
     EXPECT_EQ(FLOW_ERROR_NOT_IMPLEMENTED, -10);
+    EXPECT_EQ(FLOW_ERROR_TIMEOUT, -11);
     EXPECT_EQ(FLOW_ERROR_UNKNOWN, -999);
 }
 
@@ -1,11 +1,18 @@
 #include "flow_ffi.h"
 
+#include <flow/core/NodeData.hpp>
+
 #include <cstring>
-#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "error_handling.hpp"
 #include "handle_manager.hpp"
+#include "memory_usage.hpp"
+#include "node_data_wrapper.hpp"
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 class EnvFactoryTest : public ::testing::Test {
 protected:
@@ -310,4 +317,168 @@ TEST_F(EnvFactoryTest, HandleReferenceCountingMultipleFactories) {
     flow_release_handle(factory1);
     flow_release_handle(factory2);
     flow_env_destroy(env);
-}
\ No newline at end of file
+}
+
+TEST_F(EnvFactoryTest, MemoryUsageInvalidArguments) {
+    FlowMemoryUsage usage{};
+    EXPECT_EQ(flow_graph_get_memory_usage(nullptr, &usage), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_env_get_memory_usage(nullptr, &usage), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_get_memory_report(nullptr, 5), nullptr);
+    EXPECT_EQ(flow_data_get_memory_size(nullptr), 0u);
+
+    FlowEnvHandle env = flow_env_create(1);
+    ASSERT_NE(env, nullptr);
+    FlowGraphHandle graph = flow_graph_create(env);
+    ASSERT_NE(graph, nullptr);
+    EXPECT_EQ(flow_graph_get_memory_usage(graph, nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+
+    flow_graph_destroy(graph);
+    flow_env_destroy(env);
+}
+
+TEST_F(EnvFactoryTest, MemoryUsageOfGraphsAndEnvironments) {
+    FlowEnvHandle env = flow_env_create(1);
+    FlowEnvHandle other_env = flow_env_create(1);
+    ASSERT_NE(env, nullptr);
+    ASSERT_NE(other_env, nullptr);
+
+    FlowGraphHandle graph_a = flow_graph_create(env);
+    FlowGraphHandle graph_b = flow_graph_create(env);
+    FlowGraphHandle graph_c = flow_graph_create(other_env);
+    ASSERT_NE(graph_a, nullptr);
+    ASSERT_NE(graph_b, nullptr);
+    ASSERT_NE(graph_c, nullptr);
+
+    FlowMemoryUsage usage{};
+    ASSERT_EQ(flow_graph_get_memory_usage(graph_a, &usage), FLOW_SUCCESS);
+    EXPECT_EQ(usage.total_bytes, 0u);
+    EXPECT_EQ(usage.node_count, 0u);
+    EXPECT_EQ(usage.graph_count, 1u);
+
+    ASSERT_EQ(flow_env_get_memory_usage(env, &usage), FLOW_SUCCESS);
+    EXPECT_EQ(usage.graph_count, 2u);
+    ASSERT_EQ(flow_env_get_memory_usage(other_env, &usage), FLOW_SUCCESS);
+    EXPECT_EQ(usage.graph_count, 1u);
+
+    char* report = flow_graph_get_memory_report(graph_a, 10);
+    ASSERT_NE(report, nullptr);
+    auto graph_json = nlohmann::json::parse(report);
+    flow_free_string(report);
+    EXPECT_EQ(graph_json["total_bytes"], 0);
+    EXPECT_TRUE(graph_json["nodes"].empty());
+
+    report = flow_get_memory_report(2);
+    ASSERT_NE(report, nullptr);
+    auto all_json = nlohmann::json::parse(report);
+    flow_free_string(report);
+    EXPECT_EQ(all_json["graph_count"], 3);
+    EXPECT_EQ(all_json["graphs"].size(), 2u);
+
+    flow_graph_destroy(graph_a);
+    flow_graph_destroy(graph_b);
+    flow_graph_destroy(graph_c);
+    flow_env_destroy(env);
+    flow_env_destroy(other_env);
+}
+
+TEST_F(EnvFactoryTest, DataMemorySize) {
+    FlowNodeDataHandle number = flow_data_create_int(7);
+    FlowNodeDataHandle short_text = flow_data_create_string("abc");
+    FlowNodeDataHandle long_text = flow_data_create_string(std::string(4096, 'x').c_str());
+    ASSERT_NE(number, nullptr);
+    ASSERT_NE(short_text, nullptr);
+    ASSERT_NE(long_text, nullptr);
+
+    size_t number_size = flow_data_get_memory_size(number);
+    size_t short_size = flow_data_get_memory_size(short_text);
+    size_t long_size = flow_data_get_memory_size(long_text);
+    EXPECT_GT(number_size, 0u);
+    EXPECT_GT(short_size, 0u);
+    EXPECT_GE(long_size, short_size + 4096);
+
+    flow_data_destroy(number);
+    flow_data_destroy(short_text);
+    flow_data_destroy(long_text);
+}
+
+TEST_F(EnvFactoryTest, DataSizersForOtherTypes) {
+    using Values = std::vector<int>;
+    using ValuesData = flow::detail::NodeData<Values>;
+    auto data = std::make_shared<ValuesData>(Values(100));
+    const std::string type(data->Type());
+    auto handle = reinterpret_cast<FlowNodeDataHandle>(
+        flow_ffi::create_handle<NodeDataWrapper>(NodeDataWrapper(data)));
+    ASSERT_NE(handle, nullptr);
+
+    // Without a sizer the value is unknown rather than estimated
+    EXPECT_FALSE(flow_ffi::node_data_bytes(*data).has_value());
+    EXPECT_EQ(flow_data_get_memory_size(handle), 0u);
+    EXPECT_EQ(flow_ffi::ErrorManager::instance().get_last_error_code(),
+              FLOW_ERROR_NOT_IMPLEMENTED);
+    flow_clear_error();
+
+    FlowDataSizerFn sizer = [](const void* value) -> size_t {
+        const auto* typed = static_cast<const ValuesData*>(
+            static_cast<const flow::NodeData*>(value));
+        return sizeof(*typed) + typed->Get().capacity() * sizeof(int);
+    };
+    EXPECT_EQ(flow_register_data_sizer(nullptr, sizer), FLOW_ERROR_INVALID_ARGUMENT);
+    const std::string builtin(flow::TypeName_v<int>);
+    EXPECT_EQ(flow_register_data_sizer(builtin.c_str(), sizer), FLOW_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(flow_register_data_sizer(type.c_str(), sizer), FLOW_SUCCESS);
+    EXPECT_EQ(flow_data_get_memory_size(handle), sizeof(ValuesData) + 100 * sizeof(int));
+
+    EXPECT_EQ(flow_register_data_sizer(type.c_str(), nullptr), FLOW_SUCCESS);
+    EXPECT_FALSE(flow_ffi::node_data_bytes(*data).has_value());
+
+    flow_data_destroy(handle);
+}
+
+TEST_F(EnvFactoryTest, TopologyVersionAdvancesOnMutation) {
+    EXPECT_EQ(flow_graph_get_topology_version(nullptr), 0u);
+
+    FlowEnvHandle env = flow_env_create(1);
+    ASSERT_NE(env, nullptr);
+    FlowGraphHandle graph = flow_graph_create(env);
+    ASSERT_NE(graph, nullptr);
+
+    uint64_t version = flow_graph_get_topology_version(graph);
+    ASSERT_EQ(flow_graph_clear(graph), FLOW_SUCCESS);
+    EXPECT_GT(flow_graph_get_topology_version(graph), version);
+
+    // Queries do not change the version
+    version = flow_graph_get_topology_version(graph);
+    FlowNodeHandle* nodes = nullptr;
+    size_t count = 1;
+    ASSERT_EQ(flow_graph_get_nodes(graph, &nodes, &count), FLOW_SUCCESS);
+    EXPECT_EQ(count, 0u);
+    EXPECT_EQ(flow_graph_get_topology_version(graph), version);
+
+    flow_graph_destroy(graph);
+    flow_env_destroy(env);
+}
+
+TEST_F(EnvFactoryTest, GetNeighborsInvalidArguments) {
+    char** ids = nullptr;
+    size_t count = 0;
+    EXPECT_EQ(flow_graph_get_neighbors(nullptr, "id", FLOW_NEIGHBORS_UPSTREAM, &ids, &count),
+              FLOW_ERROR_INVALID_ARGUMENT);
+
+    FlowEnvHandle env = flow_env_create(1);
+    ASSERT_NE(env, nullptr);
+    FlowGraphHandle graph = flow_graph_create(env);
+    ASSERT_NE(graph, nullptr);
+
+    EXPECT_EQ(flow_graph_get_neighbors(graph, "id", FLOW_NEIGHBORS_UPSTREAM, nullptr, &count),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_get_neighbors(graph, "not-a-uuid", FLOW_NEIGHBORS_DOWNSTREAM, &ids,
+                                       &count),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_get_neighbors(graph, "00000000-0000-0000-0000-000000000001",
+                                       FLOW_NEIGHBORS_DOWNSTREAM, &ids, &count),
+              FLOW_ERROR_NODE_NOT_FOUND);
+
+    flow_graph_destroy(graph);
+    flow_env_destroy(env);
+}
@@ -1,9 +1,11 @@
 #include "flow_ffi.h"
 
 #include <cstring>
+#include <thread>
 
 #include "error_handling.hpp"
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 class ErrorHandlingTest : public ::testing::Test {
 protected:
@@ -182,4 +184,68 @@ TEST_F(ErrorHandlingTest, MultipleErrorsOverwrite) {
     EXPECT_STREQ(error_msg, "Second error");
 
     flow_clear_error();
-}
\ No newline at end of file
+}
+
+TEST_F(ErrorHandlingTest, EveryCallVariantReportsOutOfMemory) {
+    auto call = []() -> FlowError { FLOW_API_CALL({ throw std::bad_alloc(); }); };
+    auto call_handle = []() -> void* { FLOW_API_CALL_HANDLE({ throw std::bad_alloc(); }); };
+    auto call_void = []() { FLOW_API_CALL_VOID({ throw std::bad_alloc(); }); };
+
+    EXPECT_EQ(call(), FLOW_ERROR_OUT_OF_MEMORY);
+    EXPECT_EQ(flow_ffi::ErrorManager::instance().get_last_error_code(), FLOW_ERROR_OUT_OF_MEMORY);
+    flow_clear_error();
+
+    EXPECT_EQ(call_handle(), nullptr);
+    EXPECT_EQ(flow_ffi::ErrorManager::instance().get_last_error_code(), FLOW_ERROR_OUT_OF_MEMORY);
+    flow_clear_error();
+
+    call_void();
+    EXPECT_EQ(flow_ffi::ErrorManager::instance().get_last_error_code(), FLOW_ERROR_OUT_OF_MEMORY);
+}
+
+TEST_F(ErrorHandlingTest, ApiStatsRecordCallsAndErrors) {
+    auto call = [](bool fail) -> FlowError {
+        FLOW_API_CALL({
+            if (fail) {
+                flow_ffi::ErrorManager::instance().set_error(FLOW_ERROR_INVALID_ARGUMENT, "bad");
+                return FLOW_ERROR_INVALID_ARGUMENT;
+            }
+            return FLOW_SUCCESS;
+        });
+    };
+
+    flow_api_stats_reset();
+    call(false); // Not recorded while disabled
+
+    flow_api_stats_enable(true);
+    EXPECT_TRUE(flow_api_stats_is_enabled());
+    call(false);
+    call(false);
+    call(true);
+    std::thread([&] { call(true); }).join();
+    flow_api_stats_enable(false);
+
+    char* report = flow_get_api_stats();
+    ASSERT_NE(report, nullptr);
+    auto json = nlohmann::json::parse(report);
+    flow_free_string(report);
+
+    EXPECT_FALSE(json["enabled"].get<bool>());
+    ASSERT_EQ(json["functions"].size(), 1u);
+    const auto& stats = json["functions"][0];
+    EXPECT_EQ(stats["name"], "operator()");
+    EXPECT_EQ(stats["calls"], 4);
+    EXPECT_EQ(stats["errors"], 2);
+    EXPECT_LE(stats["p50_ns"].get<uint64_t>(), stats["max_ns"].get<uint64_t>());
+
+    uint64_t bucketed = 0;
+    for (const auto& bucket : stats["histogram"]) {
+        bucketed += bucket["count"].get<uint64_t>();
+    }
+    EXPECT_EQ(bucketed, 4u);
+
+    flow_api_stats_reset();
+    report = flow_get_api_stats();
+    EXPECT_TRUE(nlohmann::json::parse(report)["functions"].empty());
+    flow_free_string(report);
+}
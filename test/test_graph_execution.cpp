@@ -0,0 +1,1103 @@
+#include "flow_ffi.h"
+
+#include <flow/core/Node.hpp>
+#include <flow/core/NodeFactory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "env_wrapper.hpp"
+#include "graph_executor.hpp"
+#include "handle_manager.hpp"
+#include "output_cache.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr const char* kAddOneClass = "test.AddOne";
+constexpr const char* kSleepClass = "test.Sleep";
+constexpr const char* kForwardDoubleClass = "test.ForwardDouble";
+constexpr const char* kForwardBoolClass = "test.ForwardBool";
+constexpr const char* kForwardStringClass = "test.ForwardString";
+constexpr const char* kRangeClass = "test.Range";
+constexpr int kSleepMs = 300;
+
+// AddOne nodes constructed, graph nodes and the copies executing them alike
+std::atomic<int> add_one_nodes{0};
+
+// AddOne computes by node id; a graph's node and the copies executing it share the id
+std::mutex compute_counts_mutex;
+std::map<std::string, int> compute_counts;
+
+int compute_count(const std::string& node_id) {
+    std::lock_guard<std::mutex> lock(compute_counts_mutex);
+    auto it = compute_counts.find(node_id);
+    return it != compute_counts.end() ? it->second : 0;
+}
+
+void reset_compute_counts() {
+    std::lock_guard<std::mutex> lock(compute_counts_mutex);
+    compute_counts.clear();
+}
+
+// Outputs its int input plus one
+class AddOneNode : public flow::Node {
+public:
+    AddOneNode(const flow::UUID& uuid, const std::string& class_name, std::string name,
+               std::shared_ptr<flow::Env> env)
+        : flow::Node(uuid, class_name, std::move(name), std::move(env)) {
+        AddInput<int>("in", "Input");
+        AddOutput<int>("out", "Output");
+        ++add_one_nodes;
+    }
+
+protected:
+    void Compute() override {
+        {
+            std::lock_guard<std::mutex> lock(compute_counts_mutex);
+            ++compute_counts[std::string(ID())];
+        }
+        auto in = std::dynamic_pointer_cast<flow::detail::NodeData<int>>(GetInputData("in"));
+        SetOutputData("out", std::make_shared<flow::detail::NodeData<int>>(in->Get() + 1));
+    }
+};
+
+// Forwards its int input after kSleepMs
+class SleepNode : public flow::Node {
+public:
+    SleepNode(const flow::UUID& uuid, const std::string& class_name, std::string name,
+              std::shared_ptr<flow::Env> env)
+        : flow::Node(uuid, class_name, std::move(name), std::move(env)) {
+        AddInput<int>("in", "Input");
+        AddOutput<int>("out", "Output");
+    }
+
+protected:
+    void Compute() override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kSleepMs));
+        SetOutputData("out", GetInputData("in"));
+    }
+};
+
+// Forwards its input unchanged
+template <typename T> class ForwardNode : public flow::Node {
+public:
+    ForwardNode(const flow::UUID& uuid, const std::string& class_name, std::string name,
+                std::shared_ptr<flow::Env> env)
+        : flow::Node(uuid, class_name, std::move(name), std::move(env)) {
+        AddInput<T>("in", "Input");
+        AddOutput<T>("out", "Output");
+    }
+
+protected:
+    void Compute() override { SetOutputData("out", GetInputData("in")); }
+};
+
+// Outputs the numbers below its int input, a type FlowValue cannot carry
+class RangeNode : public flow::Node {
+public:
+    RangeNode(const flow::UUID& uuid, const std::string& class_name, std::string name,
+              std::shared_ptr<flow::Env> env)
+        : flow::Node(uuid, class_name, std::move(name), std::move(env)) {
+        AddInput<int>("in", "Input");
+        AddOutput<std::vector<int>>("out", "Output");
+    }
+
+protected:
+    void Compute() override {
+        auto in = std::dynamic_pointer_cast<flow::detail::NodeData<int>>(GetInputData("in"));
+        std::vector<int> range(static_cast<size_t>(std::max(in->Get(), 0)));
+        std::iota(range.begin(), range.end(), 0);
+        SetOutputData("out", std::make_shared<flow::detail::NodeData<std::vector<int>>>(
+                                 std::move(range)));
+    }
+};
+
+void register_test_nodes(FlowEnvHandle env) {
+    FlowNodeFactoryHandle factory = flow_env_get_factory(env);
+    auto* wrapper = flow_ffi::get_handle<NodeFactoryWrapper>(factory);
+    wrapper->factory->RegisterNodeClass<AddOneNode>("Test", kAddOneClass);
+    wrapper->factory->RegisterNodeClass<SleepNode>("Test", kSleepClass);
+    wrapper->factory->RegisterNodeClass<ForwardNode<double>>("Test", kForwardDoubleClass);
+    wrapper->factory->RegisterNodeClass<ForwardNode<bool>>("Test", kForwardBoolClass);
+    wrapper->factory->RegisterNodeClass<ForwardNode<std::string>>("Test", kForwardStringClass);
+    wrapper->factory->RegisterNodeClass<RangeNode>("Test", kRangeClass);
+    flow_release_handle(factory);
+}
+
+// Ids of count new nodes, each feeding its "out" to the next one's "in"
+std::vector<std::string> add_chain(FlowGraphHandle graph, const char* class_name,
+                                   size_t count) {
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < count; ++i) {
+        std::string name = "node" + std::to_string(i);
+        FlowNodeHandle node = flow_graph_add_node(graph, class_name, name.c_str());
+        ids.emplace_back(node ? flow_node_get_id(node) : "");
+        flow_release_handle(node);
+        if (i > 0) {
+            flow_release_handle(flow_graph_connect_nodes(graph, ids[i - 1].c_str(), "out",
+                                                         ids[i].c_str(), "in"));
+        }
+    }
+    return ids;
+}
+
+FlowError set_context_input(FlowContextHandle context, const std::string& node_id,
+                            int32_t value) {
+    FlowNodeDataHandle data = flow_data_create_int(value);
+    FlowError result = flow_context_set_input(context, node_id.c_str(), "in", data);
+    flow_data_destroy(data);
+    return result;
+}
+
+// The node's "out" from the context's last run, or -1 if it has none
+int32_t context_output(FlowContextHandle context, const std::string& node_id) {
+    int32_t value = -1;
+    FlowNodeDataHandle data = flow_context_get_output(context, node_id.c_str(), "out");
+    if (data) {
+        flow_data_get_int(data, &value);
+        flow_data_destroy(data);
+    }
+    return value;
+}
+
+// A plan stepping through node_count nodes in index order; edges go from lower to higher
+// indexes, so that order is topological
+flow_ffi::ExecutionPlan make_plan(size_t node_count,
+                                  const std::vector<std::pair<size_t, size_t>>& edges) {
+    auto snapshot = std::make_shared<flow_ffi::GraphSnapshot>();
+    snapshot->nodes.resize(node_count);
+    snapshot->upstream.resize(node_count);
+    snapshot->downstream.resize(node_count);
+    for (const auto& [source, target] : edges) {
+        snapshot->downstream[source].push_back(target);
+        snapshot->upstream[target].push_back(source);
+    }
+
+    flow_ffi::ExecutionPlan plan;
+    plan.snapshot = snapshot;
+    for (size_t i = 0; i < node_count; ++i) {
+        plan.steps.push_back({i, {}, {}, {}});
+        plan.step_of.push_back(i);
+    }
+    return plan;
+}
+
+} // namespace
+
+// Each test gets an environment with the test node classes and an empty graph in it
+class GraphExecutionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        flow_ffi::HandleRegistry::instance().clear();
+        flow_clear_error();
+        reset_compute_counts();
+        env_ = flow_env_create(1);
+        ASSERT_NE(env_, nullptr);
+        register_test_nodes(env_);
+        graph_ = flow_graph_create(env_);
+        ASSERT_NE(graph_, nullptr);
+    }
+
+    void TearDown() override {
+        if (graph_) {
+            flow_graph_destroy(graph_);
+        }
+        if (env_) {
+            flow_env_destroy(env_);
+        }
+        flow_ffi::HandleRegistry::instance().clear();
+        flow_clear_error();
+    }
+
+    FlowEnvHandle env_ = nullptr;
+    FlowGraphHandle graph_ = nullptr;
+};
+
+TEST_F(GraphExecutionTest, ContextInvalidArguments) {
+    EXPECT_EQ(flow_graph_create_context(nullptr), nullptr);
+    EXPECT_EQ(flow_context_run(nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_clear(nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_get_output(nullptr, "id", "out"), nullptr);
+    flow_context_destroy(nullptr);
+
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+
+    EXPECT_EQ(flow_context_set_input(context, nullptr, "in", nullptr),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_set_input(context, "not-a-uuid", "in", nullptr),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_set_input(context, "00000000-0000-0000-0000-000000000001", "in",
+                                     nullptr),
+              FLOW_ERROR_NODE_NOT_FOUND);
+    EXPECT_EQ(flow_context_get_output(context, "00000000-0000-0000-0000-000000000001", "out"),
+              nullptr);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, ContextsRunConcurrently) {
+    std::atomic<int> failures{0};
+    std::vector<std::thread> runners;
+    for (int i = 0; i < 4; ++i) {
+        runners.emplace_back([&] {
+            FlowContextHandle context = flow_graph_create_context(graph_);
+            if (!context) {
+                ++failures;
+                return;
+            }
+            for (int run = 0; run < 50; ++run) {
+                if (flow_context_run(context) != FLOW_SUCCESS) {
+                    ++failures;
+                }
+            }
+            flow_context_destroy(context);
+        });
+    }
+    for (auto& runner : runners) {
+        runner.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+
+    // Contexts outlive a cleared graph and see the change on their next run
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(flow_graph_clear(graph_), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_clear(context), FLOW_SUCCESS);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, ContextRunsChain) {
+    auto ids = add_chain(graph_, kAddOneClass, 4);
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+
+    // Every node's output stays readable, sequentially and in parallel
+    EXPECT_EQ(set_context_input(context, ids[0], 10), FLOW_SUCCESS);
+    for (size_t threads : {size_t{1}, size_t{2}}) {
+        EXPECT_EQ(flow_context_set_parallelism(context, threads), FLOW_SUCCESS);
+        EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+        EXPECT_EQ(context_output(context, ids[1]), 12);
+        EXPECT_EQ(context_output(context, ids[3]), 14);
+
+        FlowRunStats stats{};
+        EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+        EXPECT_EQ(stats.nodes_computed, 4u);
+    }
+
+    // The graph's own nodes are left alone
+    FlowNodeHandle last = flow_graph_get_node(graph_, ids[3].c_str());
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(flow_node_get_output_data(last, "out"), nullptr);
+    flow_release_handle(last);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, ContextsKeepTheirOwnValues) {
+    auto ids = add_chain(graph_, kAddOneClass, 4);
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> runners;
+    for (int i = 0; i < 4; ++i) {
+        runners.emplace_back([&, i] {
+            FlowContextHandle context = flow_graph_create_context(graph_);
+            if (!context) {
+                ++failures;
+                return;
+            }
+            flow_context_set_parallelism(context, i % 2 + 1);
+            for (int run = 0; run < 50; ++run) {
+                const int32_t input = i * 1000 + run;
+                if (set_context_input(context, ids[0], input) != FLOW_SUCCESS ||
+                    flow_context_run(context) != FLOW_SUCCESS ||
+                    context_output(context, ids[3]) != input + 4) {
+                    ++failures;
+                }
+            }
+            flow_context_destroy(context);
+        });
+    }
+    for (auto& runner : runners) {
+        runner.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+}
+
+TEST_F(GraphExecutionTest, GraphPoolAcquireRelease) {
+    EXPECT_EQ(flow_graph_pool_create(nullptr, 2), nullptr);
+    EXPECT_EQ(flow_graph_pool_acquire(nullptr, 0), nullptr);
+    EXPECT_EQ(flow_graph_pool_release(nullptr, nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_pool_available(nullptr), 0u);
+
+    EXPECT_EQ(flow_graph_pool_create(graph_, 0), nullptr);
+    EXPECT_NE(flow_get_last_error(), nullptr);
+
+    FlowGraphPoolHandle pool = flow_graph_pool_create(graph_, 2);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(flow_graph_pool_available(pool), 2u);
+
+    FlowContextHandle first = flow_graph_pool_acquire(pool, 0);
+    FlowContextHandle second = flow_graph_pool_acquire(pool, -1);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(flow_graph_pool_available(pool), 0u);
+
+    EXPECT_EQ(flow_graph_pool_acquire(pool, 10), nullptr);
+    ASSERT_NE(flow_get_last_error(), nullptr);
+    EXPECT_NE(std::string(flow_get_last_error()).find("Timed out"), std::string::npos);
+
+    EXPECT_EQ(flow_context_run(first), FLOW_SUCCESS);
+    EXPECT_EQ(flow_graph_pool_release(pool, first), FLOW_SUCCESS);
+    EXPECT_EQ(flow_graph_pool_release(pool, first), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_pool_available(pool), 1u);
+
+    // A waiting acquire is woken by a release from another thread
+    std::thread releaser([&] { flow_graph_pool_release(pool, second); });
+    FlowContextHandle again = flow_graph_pool_acquire(pool, -1);
+    releaser.join();
+    EXPECT_NE(again, nullptr);
+    EXPECT_EQ(flow_graph_pool_release(pool, again), FLOW_SUCCESS);
+
+    // Pooled contexts are only returned, never destroyed by the caller
+    FlowContextHandle pooled = flow_graph_pool_acquire(pool, 0);
+    ASSERT_NE(pooled, nullptr);
+    flow_context_destroy(pooled);
+    EXPECT_NE(flow_get_last_error(), nullptr);
+    EXPECT_TRUE(flow_is_valid_handle(pooled));
+    EXPECT_EQ(flow_graph_pool_release(pool, pooled), FLOW_SUCCESS);
+
+    FlowContextHandle foreign = flow_graph_create_context(graph_);
+    ASSERT_NE(foreign, nullptr);
+    EXPECT_EQ(flow_graph_pool_release(pool, foreign), FLOW_ERROR_INVALID_ARGUMENT);
+    flow_context_destroy(foreign);
+
+    // A context comes back with neither the inputs nor the outputs of its last use
+    auto ids = add_chain(graph_, kAddOneClass, 2);
+    FlowContextHandle context = flow_graph_pool_acquire(pool, 0);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(set_context_input(context, ids[0], 5), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(context_output(context, ids[1]), 7);
+    EXPECT_EQ(flow_graph_pool_release(pool, context), FLOW_SUCCESS);
+
+    ASSERT_EQ(flow_graph_pool_acquire(pool, 0), context); // The last one released
+    EXPECT_EQ(context_output(context, ids[1]), -1);
+    FlowRunStats stats{};
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_computed, 0u);
+    EXPECT_EQ(stats.nodes_not_ready, 2u);
+    EXPECT_EQ(flow_graph_pool_release(pool, context), FLOW_SUCCESS);
+
+    flow_graph_pool_destroy(pool);
+}
+
+TEST_F(GraphExecutionTest, PooledWorkersSurviveTopologyChanges) {
+    auto ids = add_chain(graph_, kAddOneClass, 2);
+    const int graph_nodes = add_one_nodes.load();
+    FlowGraphPoolHandle pool = flow_graph_pool_create(graph_, 2);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(add_one_nodes.load(), graph_nodes + 4); // Two copies per node
+
+    FlowContextHandle context = flow_graph_pool_acquire(pool, 0);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(set_context_input(context, ids[0], 1), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(add_one_nodes.load(), graph_nodes + 4);
+
+    // Adding a node keeps the copies of the others; only the new one needs a copy
+    auto added = add_chain(graph_, kAddOneClass, 1);
+    flow_release_handle(
+        flow_graph_connect_nodes(graph_, ids[1].c_str(), "out", added[0].c_str(), "in"));
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(context_output(context, added[0]), 4);
+    EXPECT_EQ(add_one_nodes.load(), graph_nodes + 4 + 2);
+
+    EXPECT_EQ(flow_graph_pool_release(pool, context), FLOW_SUCCESS);
+    flow_graph_pool_destroy(pool);
+}
+
+TEST_F(GraphExecutionTest, InvokeWithBindings) {
+    FlowValue value{};
+    EXPECT_EQ(flow_graph_set_bindings(nullptr, nullptr, 0, nullptr, 0),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_invoke(nullptr, nullptr, &value), FLOW_ERROR_INVALID_ARGUMENT);
+
+    // Bindings must be declared before the first invocation
+    EXPECT_EQ(flow_graph_invoke(graph_, nullptr, nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+
+    FlowPortRef missing{"00000000-0000-0000-0000-000000000001", "in"};
+    FlowPortRef malformed{"not-a-uuid", "in"};
+    EXPECT_EQ(flow_graph_set_bindings(graph_, &missing, 1, nullptr, 0), FLOW_ERROR_NODE_NOT_FOUND);
+    EXPECT_EQ(flow_graph_set_bindings(graph_, nullptr, 0, &malformed, 1),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_set_bindings(graph_, nullptr, 1, nullptr, 0),
+              FLOW_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(flow_graph_set_bindings(graph_, nullptr, 0, nullptr, 0), FLOW_SUCCESS);
+    EXPECT_EQ(flow_graph_invoke(graph_, nullptr, nullptr), FLOW_SUCCESS);
+
+    value.type = FLOW_VALUE_INT;
+    value.as.int_value = 7;
+    flow_free_values(&value, 1);
+    EXPECT_EQ(value.type, FLOW_VALUE_NONE);
+    flow_free_values(nullptr, 3);
+}
+
+TEST_F(GraphExecutionTest, InvokePacksAndUnpacksValues) {
+    auto chain = add_chain(graph_, kAddOneClass, 3);
+    auto number = add_chain(graph_, kForwardDoubleClass, 1);
+    auto flag = add_chain(graph_, kForwardBoolClass, 1);
+    auto text = add_chain(graph_, kForwardStringClass, 1);
+
+    const FlowPortRef inputs[] = {{chain[0].c_str(), "in"},
+                                  {number[0].c_str(), "in"},
+                                  {flag[0].c_str(), "in"},
+                                  {text[0].c_str(), "in"}};
+    const FlowPortRef outputs[] = {{chain[2].c_str(), "out"},
+                                   {number[0].c_str(), "out"},
+                                   {flag[0].c_str(), "out"},
+                                   {text[0].c_str(), "out"}};
+    ASSERT_EQ(flow_graph_set_bindings(graph_, inputs, 4, outputs, 4), FLOW_SUCCESS);
+
+    const std::string bytes("a\0b", 3);
+    FlowValue in[4] = {};
+    in[0].type = FLOW_VALUE_INT;
+    in[0].as.int_value = 5;
+    in[1].type = FLOW_VALUE_DOUBLE;
+    in[1].as.double_value = 2.5;
+    in[2].type = FLOW_VALUE_BOOL;
+    in[2].as.bool_value = true;
+    in[3].type = FLOW_VALUE_STRING;
+    in[3].as.string_value = {bytes.data(), bytes.size()};
+
+    FlowValue out[4] = {};
+    ASSERT_EQ(flow_graph_invoke(graph_, in, out), FLOW_SUCCESS);
+    ASSERT_EQ(out[0].type, FLOW_VALUE_INT);
+    EXPECT_EQ(out[0].as.int_value, 8);
+    ASSERT_EQ(out[1].type, FLOW_VALUE_DOUBLE);
+    EXPECT_EQ(out[1].as.double_value, 2.5);
+    ASSERT_EQ(out[2].type, FLOW_VALUE_BOOL);
+    EXPECT_TRUE(out[2].as.bool_value);
+    ASSERT_EQ(out[3].type, FLOW_VALUE_STRING);
+    EXPECT_EQ(std::string(out[3].as.string_value.data, out[3].as.string_value.size), bytes);
+    EXPECT_NE(out[3].as.string_value.data, bytes.data());
+    flow_free_values(out, 4);
+    EXPECT_EQ(out[3].type, FLOW_VALUE_NONE);
+
+    // An input left as NONE keeps its node from running, so its output is NONE too
+    in[0].type = FLOW_VALUE_NONE;
+    in[3].type = FLOW_VALUE_NONE;
+    ASSERT_EQ(flow_graph_invoke(graph_, in, out), FLOW_SUCCESS);
+    EXPECT_EQ(out[0].type, FLOW_VALUE_NONE);
+    EXPECT_EQ(out[1].type, FLOW_VALUE_DOUBLE);
+    EXPECT_EQ(out[2].type, FLOW_VALUE_BOOL);
+    EXPECT_EQ(out[3].type, FLOW_VALUE_NONE);
+    flow_free_values(out, 4);
+
+    // Invocations leave the graph's own nodes alone
+    FlowNodeHandle last = flow_graph_get_node(graph_, chain[2].c_str());
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(flow_node_get_output_data(last, "out"), nullptr);
+    flow_release_handle(last);
+}
+
+TEST_F(GraphExecutionTest, InvokeRejectsOutputsFlowValueCannotCarry) {
+    auto chain = add_chain(graph_, kAddOneClass, 1);
+    auto range = add_chain(graph_, kRangeClass, 1);
+
+    const FlowPortRef inputs[] = {{chain[0].c_str(), "in"}, {range[0].c_str(), "in"}};
+    const FlowPortRef outputs[] = {{chain[0].c_str(), "out"}, {range[0].c_str(), "out"}};
+    ASSERT_EQ(flow_graph_set_bindings(graph_, inputs, 2, outputs, 2), FLOW_SUCCESS);
+
+    FlowValue in[2] = {};
+    in[0].type = FLOW_VALUE_INT;
+    in[0].as.int_value = 1;
+    in[1].type = FLOW_VALUE_INT;
+    in[1].as.int_value = 3;
+    FlowValue out[2] = {};
+    EXPECT_EQ(flow_graph_invoke(graph_, in, out), FLOW_ERROR_TYPE_MISMATCH);
+    ASSERT_NE(flow_get_last_error(), nullptr);
+    EXPECT_NE(std::string(flow_get_last_error()).find("Output 1"), std::string::npos);
+    // Outputs unpacked before the failure are released again
+    EXPECT_EQ(out[0].type, FLOW_VALUE_NONE);
+    EXPECT_EQ(out[1].type, FLOW_VALUE_NONE);
+
+    // Without a value the port produces nothing, which NONE carries
+    in[1].type = FLOW_VALUE_NONE;
+    ASSERT_EQ(flow_graph_invoke(graph_, in, out), FLOW_SUCCESS);
+    ASSERT_EQ(out[0].type, FLOW_VALUE_INT);
+    EXPECT_EQ(out[0].as.int_value, 2);
+    EXPECT_EQ(out[1].type, FLOW_VALUE_NONE);
+}
+
+TEST_F(GraphExecutionTest, InvokeRunsConcurrently) {
+    auto chain = add_chain(graph_, kAddOneClass, 4);
+    auto text = add_chain(graph_, kForwardStringClass, 1);
+    const FlowPortRef inputs[] = {{chain[0].c_str(), "in"}, {text[0].c_str(), "in"}};
+    const FlowPortRef outputs[] = {{chain[3].c_str(), "out"}, {text[0].c_str(), "out"}};
+    ASSERT_EQ(flow_graph_set_bindings(graph_, inputs, 2, outputs, 2), FLOW_SUCCESS);
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; ++i) {
+        callers.emplace_back([&, i] {
+            for (int call = 0; call < 50; ++call) {
+                const int32_t number = i * 1000 + call;
+                const std::string label = std::to_string(number);
+                FlowValue in[2] = {};
+                in[0].type = FLOW_VALUE_INT;
+                in[0].as.int_value = number;
+                in[1].type = FLOW_VALUE_STRING;
+                in[1].as.string_value = {label.data(), label.size()};
+
+                FlowValue out[2] = {};
+                if (flow_graph_invoke(graph_, in, out) != FLOW_SUCCESS ||
+                    out[0].type != FLOW_VALUE_INT || out[0].as.int_value != number + 4 ||
+                    out[1].type != FLOW_VALUE_STRING ||
+                    std::string(out[1].as.string_value.data, out[1].as.string_value.size) !=
+                        label) {
+                    ++failures;
+                }
+                flow_free_values(out, 2);
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+}
+
+TEST_F(GraphExecutionTest, EvaluateInvalidArguments) {
+    EXPECT_EQ(flow_graph_evaluate(nullptr, "id", "out"), nullptr);
+    EXPECT_EQ(flow_graph_clear_evaluation_cache(nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(flow_graph_evaluate(graph_, nullptr, "out"), nullptr);
+    EXPECT_EQ(flow_graph_evaluate(graph_, "not-a-uuid", "out"), nullptr);
+    EXPECT_NE(flow_get_last_error(), nullptr);
+
+    EXPECT_EQ(flow_graph_evaluate(graph_, "00000000-0000-0000-0000-000000000001", "out"),
+              nullptr);
+    ASSERT_NE(flow_get_last_error(), nullptr);
+    EXPECT_NE(std::string(flow_get_last_error()).find("Node not found"), std::string::npos);
+
+    EXPECT_EQ(flow_graph_clear_evaluation_cache(graph_), FLOW_SUCCESS);
+}
+
+TEST_F(GraphExecutionTest, EvaluateComputesUpstreamConeAndReusesOutputs) {
+    // root feeds left and right; left feeds leaf; other stands apart
+    auto left_chain = add_chain(graph_, kAddOneClass, 3);
+    auto right = add_chain(graph_, kAddOneClass, 1);
+    auto other = add_chain(graph_, kAddOneClass, 1);
+    const std::string& root = left_chain[0];
+    const std::string& left = left_chain[1];
+    const std::string& leaf = left_chain[2];
+    flow_release_handle(
+        flow_graph_connect_nodes(graph_, root.c_str(), "out", right[0].c_str(), "in"));
+
+    // Inputs held by the graph's own nodes; setting them computes those nodes in place
+    auto set_node_input = [&](const std::string& id, int32_t value) {
+        FlowNodeHandle node = flow_graph_get_node(graph_, id.c_str());
+        ASSERT_NE(node, nullptr);
+        FlowNodeDataHandle data = flow_data_create_int(value);
+        EXPECT_EQ(flow_node_set_input_data(node, "in", data), FLOW_SUCCESS);
+        flow_data_destroy(data);
+        flow_release_handle(node);
+        flow_env_wait(env_);
+    };
+    auto evaluate = [&](const std::string& id) {
+        int32_t value = -1;
+        FlowNodeDataHandle data = flow_graph_evaluate(graph_, id.c_str(), "out");
+        if (data) {
+            flow_data_get_int(data, &value);
+            flow_data_destroy(data);
+        }
+        return value;
+    };
+    set_node_input(root, 1);
+    set_node_input(other[0], 1);
+    reset_compute_counts();
+
+    // Only the nodes the output depends on compute
+    EXPECT_EQ(evaluate(left), 3);
+    EXPECT_EQ(compute_count(root), 1);
+    EXPECT_EQ(compute_count(left), 1);
+    EXPECT_EQ(compute_count(leaf), 0);
+    EXPECT_EQ(compute_count(right[0]), 0);
+    EXPECT_EQ(compute_count(other[0]), 0);
+
+    // With its inputs unchanged the output is served from the cache
+    EXPECT_EQ(evaluate(left), 3);
+    EXPECT_EQ(compute_count(root), 1);
+    EXPECT_EQ(compute_count(left), 1);
+
+    // The other branch reuses the shared upstream node
+    EXPECT_EQ(evaluate(right[0]), 3);
+    EXPECT_EQ(compute_count(root), 1);
+    EXPECT_EQ(compute_count(right[0]), 1);
+
+    // A new input recomputes the cone from the changed node down, and nothing else
+    set_node_input(root, 10);
+    reset_compute_counts();
+    EXPECT_EQ(evaluate(leaf), 13);
+    EXPECT_EQ(compute_count(root), 1);
+    EXPECT_EQ(compute_count(left), 1);
+    EXPECT_EQ(compute_count(leaf), 1);
+    EXPECT_EQ(compute_count(right[0]), 0);
+
+    // Clearing the cache computes the cone again
+    EXPECT_EQ(flow_graph_clear_evaluation_cache(graph_), FLOW_SUCCESS);
+    reset_compute_counts();
+    EXPECT_EQ(evaluate(leaf), 13);
+    EXPECT_EQ(compute_count(root), 1);
+    EXPECT_EQ(compute_count(leaf), 1);
+}
+
+TEST_F(GraphExecutionTest, DeadNodeEliminationOptions) {
+    FlowRunStats stats{};
+    EXPECT_EQ(flow_graph_set_sink(nullptr, "id", "out", true), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_set_dead_node_elimination(nullptr, true), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_get_run_stats(nullptr, &stats), FLOW_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(flow_graph_set_sink(graph_, "00000000-0000-0000-0000-000000000001", "out", true),
+              FLOW_ERROR_NODE_NOT_FOUND);
+    EXPECT_EQ(flow_graph_set_sink(graph_, "not-a-uuid", "out", false),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_set_sink(graph_, "00000000-0000-0000-0000-000000000001", "out", false),
+              FLOW_SUCCESS);
+
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(flow_context_get_run_stats(context, nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_set_dead_node_elimination(context, true), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_computed, 0u);
+    EXPECT_EQ(stats.nodes_skipped_dead, 0u);
+    EXPECT_EQ(stats.nodes_not_ready, 0u);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, DeadNodesAreSkipped) {
+    auto chain = add_chain(graph_, kAddOneClass, 2);
+    auto unused = add_chain(graph_, kAddOneClass, 1);
+    EXPECT_EQ(flow_graph_set_sink(graph_, chain[1].c_str(), "out", true), FLOW_SUCCESS);
+
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(set_context_input(context, chain[0], 1), FLOW_SUCCESS);
+    EXPECT_EQ(set_context_input(context, unused[0], 1), FLOW_SUCCESS);
+
+    // Only the node feeding no sink is left out
+    FlowRunStats stats{};
+    EXPECT_EQ(flow_context_set_dead_node_elimination(context, true), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_computed, 2u);
+    EXPECT_EQ(stats.nodes_skipped_dead, 1u);
+    EXPECT_EQ(context_output(context, chain[1]), 3);
+    EXPECT_EQ(context_output(context, unused[0]), -1);
+
+    EXPECT_EQ(flow_context_set_dead_node_elimination(context, false), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_computed, 3u);
+    EXPECT_EQ(stats.nodes_skipped_dead, 0u);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, ConstantFoldingOption) {
+    EXPECT_EQ(flow_context_set_constant_folding(nullptr, false), FLOW_ERROR_INVALID_ARGUMENT);
+
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+
+    FlowRunStats stats{};
+    for (bool enabled : {true, false}) {
+        EXPECT_EQ(flow_context_set_constant_folding(context, enabled), FLOW_SUCCESS);
+        EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+        EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+        EXPECT_EQ(stats.nodes_folded, 0u);
+    }
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, ConstantNodesAreFolded) {
+    auto ids = add_chain(graph_, kAddOneClass, 2);
+
+    // A value held by the graph's node, not set per run, makes the chain constant
+    FlowNodeHandle first = flow_graph_get_node(graph_, ids[0].c_str());
+    ASSERT_NE(first, nullptr);
+    FlowNodeDataHandle data = flow_data_create_int(5);
+    EXPECT_EQ(flow_node_set_input_data(first, "in", data), FLOW_SUCCESS);
+    flow_data_destroy(data);
+    flow_release_handle(first);
+    flow_env_wait(env_);
+
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(flow_context_set_constant_folding(context, true), FLOW_SUCCESS);
+
+    FlowRunStats stats{};
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_computed, 2u);
+    EXPECT_EQ(stats.nodes_folded, 0u);
+
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_computed, 0u);
+    EXPECT_EQ(stats.nodes_folded, 2u);
+    EXPECT_EQ(context_output(context, ids[1]), 7);
+
+    // A value set on the context is per run, so its node and everything after it computes
+    EXPECT_EQ(set_context_input(context, ids[0], 5), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_computed, 2u);
+    EXPECT_EQ(stats.nodes_folded, 0u);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, ParallelRunOptions) {
+    EXPECT_EQ(flow_context_set_parallelism(nullptr, 4), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_graph_set_fusion_threshold(nullptr, 0), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_set_scheduling_policy(nullptr, FLOW_SCHEDULE_FIFO),
+              FLOW_ERROR_INVALID_ARGUMENT);
+
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+
+    EXPECT_EQ(flow_graph_set_fusion_threshold(graph_, 0), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_set_scheduling_policy(context, static_cast<FlowSchedulingPolicy>(7)),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_context_set_scheduling_policy(context, FLOW_SCHEDULE_FIFO), FLOW_SUCCESS);
+    FlowRunStats stats{};
+    for (size_t threads : {size_t{0}, size_t{1}, size_t{4}}) {
+        EXPECT_EQ(flow_context_set_parallelism(context, threads), FLOW_SUCCESS);
+        EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+        EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+        EXPECT_EQ(stats.tasks_scheduled, 0u);
+    }
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, ChainsAreFusedIntoOneTask) {
+    auto ids = add_chain(graph_, kAddOneClass, 8);
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(flow_context_set_parallelism(context, 2), FLOW_SUCCESS);
+    EXPECT_EQ(set_context_input(context, ids[0], 0), FLOW_SUCCESS);
+
+    FlowRunStats stats{};
+    EXPECT_EQ(flow_graph_set_fusion_threshold(graph_, UINT64_MAX), FLOW_SUCCESS);
+    for (int run = 0; run < 2; ++run) { // Unmeasured, then measured
+        EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+        EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+        EXPECT_EQ(stats.tasks_scheduled, 1u);
+        EXPECT_EQ(stats.nodes_computed, 8u);
+        EXPECT_EQ(context_output(context, ids[7]), 8);
+    }
+
+    EXPECT_EQ(flow_graph_set_fusion_threshold(graph_, 0), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_get_run_stats(context, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.tasks_scheduled, 8u);
+    EXPECT_EQ(context_output(context, ids[7]), 8);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, TaskGraphCriticalPaths) {
+    // 0 feeds 1 and 2, which both feed 3
+    auto plan = make_plan(4, {{0, 1}, {0, 2}, {1, 3}, {2, 3}});
+    const uint64_t costs[] = {10, 100, 5, 1};
+    auto cost = [&](size_t node) { return costs[node]; };
+
+    auto tasks = flow_ffi::build_task_graph(plan, cost, 1000);
+    ASSERT_EQ(tasks.tasks.size(), 4u); // Nothing to fuse across a fork or a join
+    ASSERT_EQ(tasks.roots, std::vector<size_t>{0});
+    EXPECT_EQ(tasks.tasks[3].dependencies, 2u);
+
+    // Each node adds 1 to its cost; a fork takes its longest branch
+    EXPECT_EQ(tasks.tasks[3].critical_path_ns, 2u);
+    EXPECT_EQ(tasks.tasks[2].critical_path_ns, 8u);
+    EXPECT_EQ(tasks.tasks[1].critical_path_ns, 103u);
+    EXPECT_EQ(tasks.tasks[0].critical_path_ns, 114u);
+
+    // Unmeasured nodes leave the node count to decide
+    tasks = flow_ffi::build_task_graph(plan, [](size_t) { return uint64_t{0}; }, 0);
+    EXPECT_EQ(tasks.tasks[0].critical_path_ns, 3u);
+    EXPECT_EQ(tasks.tasks[2].critical_path_ns, 2u);
+}
+
+TEST_F(GraphExecutionTest, TaskGraphFusesChainsWithinThreshold) {
+    auto plan = make_plan(3, {{0, 1}, {1, 2}});
+    const uint64_t costs[] = {10, 20, 30};
+    auto cost = [&](size_t node) { return costs[node]; };
+
+    auto tasks = flow_ffi::build_task_graph(plan, cost, 0);
+    ASSERT_EQ(tasks.tasks.size(), 3u);
+    EXPECT_EQ(tasks.tasks[0].critical_path_ns, 63u);
+    EXPECT_EQ(tasks.tasks[1].critical_path_ns, 52u);
+    EXPECT_EQ(tasks.tasks[2].critical_path_ns, 31u);
+
+    // 0 and 1 fit in 30 ns, 2 would not
+    tasks = flow_ffi::build_task_graph(plan, cost, 30);
+    ASSERT_EQ(tasks.tasks.size(), 2u);
+    EXPECT_EQ(tasks.tasks[0].steps, (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(tasks.tasks[0].cost_ns, 30u);
+    EXPECT_EQ(tasks.tasks[0].next, std::vector<size_t>{1});
+    EXPECT_EQ(tasks.tasks[1].dependencies, 1u);
+    EXPECT_EQ(tasks.tasks[0].critical_path_ns, 63u);
+
+    tasks = flow_ffi::build_task_graph(plan, cost, 60);
+    ASSERT_EQ(tasks.tasks.size(), 1u);
+    EXPECT_EQ(tasks.tasks[0].critical_path_ns, 63u);
+    EXPECT_EQ(tasks.roots, std::vector<size_t>{0});
+}
+
+TEST_F(GraphExecutionTest, RunTimeouts) {
+    EXPECT_EQ(flow_context_set_timeouts(nullptr, 10, 100), FLOW_ERROR_INVALID_ARGUMENT);
+
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+
+    // Budgets set or cleared, an empty graph finishes well within them
+    EXPECT_EQ(flow_context_set_timeouts(context, 10, 100), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_set_timeouts(context, 0, 0), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+
+    flow_context_destroy(context);
+}
+
+TEST_F(GraphExecutionTest, SlowNodeTimesOut) {
+    auto fast = add_chain(graph_, kAddOneClass, 1);
+    auto slow = add_chain(graph_, kSleepClass, 1);
+    flow_release_handle(
+        flow_graph_connect_nodes(graph_, fast[0].c_str(), "out", slow[0].c_str(), "in"));
+    FlowContextHandle context = flow_graph_create_context(graph_);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(set_context_input(context, fast[0], 1), FLOW_SUCCESS);
+
+    // Either budget returns before the node does, keeping what finished in time
+    const std::pair<uint64_t, uint64_t> budgets[] = {{20, 0}, {0, 20}};
+    for (const auto& [node_ms, run_ms] : budgets) {
+        EXPECT_EQ(flow_context_set_timeouts(context, node_ms, run_ms), FLOW_SUCCESS);
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(flow_context_run(context), FLOW_ERROR_TIMEOUT);
+        EXPECT_LT(std::chrono::steady_clock::now() - start,
+                  std::chrono::milliseconds(kSleepMs - 50));
+        const char* error = flow_get_last_error();
+        ASSERT_NE(error, nullptr);
+        EXPECT_NE(strstr(error, "timed out"), nullptr);
+        EXPECT_EQ(context_output(context, fast[0]), 2);
+        EXPECT_EQ(context_output(context, slow[0]), -1);
+        flow_clear_error();
+    }
+
+    // A budget the node fits in
+    EXPECT_EQ(flow_context_set_timeouts(context, kSleepMs * 10, kSleepMs * 10), FLOW_SUCCESS);
+    EXPECT_EQ(flow_context_run(context), FLOW_SUCCESS);
+    EXPECT_EQ(context_output(context, slow[0]), 2);
+
+    flow_context_destroy(context);
+    // The abandoned nodes return before their environment goes
+    std::this_thread::sleep_for(std::chrono::milliseconds(kSleepMs));
+}
+
+TEST_F(GraphExecutionTest, OutputCacheOption) {
+    auto dir = std::filesystem::temp_directory_path() / "flow_ffi_output_cache_option";
+    std::filesystem::remove_all(dir);
+
+    EXPECT_EQ(flow_graph_set_output_cache(nullptr, dir.string().c_str(), 0, 0),
+              FLOW_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(flow_graph_set_output_cache(graph_, dir.string().c_str(), 1 << 20, 0),
+              FLOW_SUCCESS);
+    EXPECT_TRUE(std::filesystem::is_directory(dir));
+    EXPECT_EQ(flow_graph_set_output_cache(graph_, nullptr, 0, 0), FLOW_SUCCESS);
+
+    // A regular file cannot hold entries
+    auto file = dir / "not_a_directory";
+    { std::ofstream(file) << "x"; }
+    EXPECT_EQ(flow_graph_set_output_cache(graph_, file.string().c_str(), 0, 0),
+              FLOW_ERROR_INVALID_ARGUMENT);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(GraphExecutionTest, OutputCacheStoresAndEvicts) {
+    auto dir = std::filesystem::temp_directory_path() / "flow_ffi_output_cache";
+    std::filesystem::remove_all(dir);
+
+    using flow::detail::NodeData;
+    auto cache = flow_ffi::OutputCache::open(dir, 0);
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(flow_ffi::OutputCache::open(dir, 0), cache);
+
+    flow_ffi::OutputCache::PortValues outputs{
+        {"count", std::make_shared<NodeData<int>>(42)},
+        {"ratio", std::make_shared<NodeData<double>>(0.5)},
+        {"flag", std::make_shared<NodeData<bool>>(true)},
+        {"text", std::make_shared<NodeData<std::string>>(std::string("a\0b", 3))}};
+    const flow_ffi::OutputCache::Key entry{"entry", "entry key"};
+    ASSERT_TRUE(cache->store(entry, outputs));
+
+    flow_ffi::OutputCache::PortValues loaded;
+    ASSERT_TRUE(cache->find(entry, loaded));
+    ASSERT_EQ(loaded.size(), 4u);
+    EXPECT_EQ(std::static_pointer_cast<NodeData<int>>(loaded["count"])->Get(), 42);
+    EXPECT_EQ(std::static_pointer_cast<NodeData<double>>(loaded["ratio"])->Get(), 0.5);
+    EXPECT_TRUE(std::static_pointer_cast<NodeData<bool>>(loaded["flag"])->Get());
+    EXPECT_EQ(std::static_pointer_cast<NodeData<std::string>>(loaded["text"])->Get(),
+              std::string("a\0b", 3));
+    EXPECT_FALSE(cache->find({"missing", "missing key"}, loaded));
+
+    // A different key with the same hash misses and leaves the entry in place
+    EXPECT_FALSE(cache->find({"entry", "colliding key"}, loaded));
+    EXPECT_TRUE(cache->find(entry, loaded));
+
+    // Corrupt entries are misses and get removed
+    { std::ofstream(dir / "corrupt.out", std::ios::binary) << "FLOC"; }
+    EXPECT_FALSE(cache->find({"corrupt", "corrupt key"}, loaded));
+    EXPECT_FALSE(std::filesystem::exists(dir / "corrupt.out"));
+
+    // With room for one entry, storing a second evicts the least recently used
+    const auto entry_size = std::filesystem::file_size(dir / "entry.out");
+    cache = flow_ffi::OutputCache::open(dir, entry_size + entry_size / 2);
+    std::filesystem::last_write_time(dir / "entry.out",
+                                     std::filesystem::file_time_type::clock::now() -
+                                         std::chrono::hours(1));
+    const flow_ffi::OutputCache::Key newer{"newer", "newer key"};
+    ASSERT_TRUE(cache->store(newer, outputs));
+    EXPECT_FALSE(cache->find(entry, loaded));
+    EXPECT_TRUE(cache->find(newer, loaded));
+
+    cache.reset();
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(GraphExecutionTest, ConcurrentQueriesWhileMutating) {
+    // A connection that is always there, so every consistent view has one to check
+    auto base = add_chain(graph_, kAddOneClass, 2);
+
+    // Node ids, connections and neighbors from one topology version must agree. Queries
+    // interleaved with a change see different versions and are not compared.
+    auto check_view = [&](int& checked) {
+        const uint64_t version = flow_graph_get_topology_version(graph_);
+
+        FlowNodeHandle* nodes = nullptr;
+        size_t node_count = 0;
+        if (flow_graph_get_nodes(graph_, &nodes, &node_count) != FLOW_SUCCESS) {
+            return false;
+        }
+        std::set<std::string> node_ids;
+        for (size_t i = 0; i < node_count; ++i) {
+            node_ids.insert(flow_node_get_id(nodes[i]));
+            flow_release_handle(nodes[i]);
+        }
+        flow_free_handle_array(reinterpret_cast<void**>(nodes));
+
+        FlowConnectionInfo* connections = nullptr;
+        size_t connection_count = 0;
+        if (flow_graph_get_connections(graph_, &connections, &connection_count) !=
+            FLOW_SUCCESS) {
+            return false;
+        }
+
+        auto neighbor_ids = [&](const char* id, FlowNeighborDirection direction) {
+            std::set<std::string> ids;
+            char** neighbors = nullptr;
+            size_t count = 0;
+            if (flow_graph_get_neighbors(graph_, id, direction, &neighbors, &count) ==
+                FLOW_SUCCESS) {
+                ids.insert(neighbors, neighbors + count);
+                flow_free_string_array(neighbors, count);
+            }
+            return ids;
+        };
+
+        bool consistent = true;
+        for (size_t i = 0; i < connection_count; ++i) {
+            const auto& connection = connections[i];
+            consistent = consistent && node_ids.count(connection.source_node_id) &&
+                         node_ids.count(connection.target_node_id) &&
+                         neighbor_ids(connection.source_node_id, FLOW_NEIGHBORS_DOWNSTREAM)
+                             .count(connection.target_node_id) &&
+                         neighbor_ids(connection.target_node_id, FLOW_NEIGHBORS_UPSTREAM)
+                             .count(connection.source_node_id);
+        }
+        flow_free_connection_array(connections, connection_count);
+
+        if (flow_graph_get_topology_version(graph_) != version) {
+            return true;
+        }
+        ++checked;
+        return consistent && node_ids.count(base[0]) && node_ids.count(base[1]) &&
+               connection_count > 0;
+    };
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            // Until the writer is done and at least one stable view was compared
+            int checked = 0;
+            while (!done.load() || checked == 0) {
+                if (!check_view(checked)) {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    // Nodes come and go, connected to each other and to the base chain
+    for (int i = 0; i < 200; ++i) {
+        auto pair = add_chain(graph_, kAddOneClass, 2);
+        flow_release_handle(
+            flow_graph_connect_nodes(graph_, base[1].c_str(), "out", pair[0].c_str(), "in"));
+        EXPECT_EQ(flow_graph_remove_node(graph_, pair[0].c_str()), FLOW_SUCCESS);
+        EXPECT_EQ(flow_graph_remove_node(graph_, pair[1].c_str()), FLOW_SUCCESS);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+
+    FlowNodeHandle* nodes = nullptr;
+    size_t node_count = 0;
+    ASSERT_EQ(flow_graph_get_nodes(graph_, &nodes, &node_count), FLOW_SUCCESS);
+    EXPECT_EQ(node_count, 2u);
+    for (size_t i = 0; i < node_count; ++i) {
+        flow_release_handle(nodes[i]);
+    }
+    flow_free_handle_array(reinterpret_cast<void**>(nodes));
+}
@@ -168,4 +168,34 @@ TEST_F(HandleManagerTest, HandleRegistry) {
 
     // Registry should be empty again
     EXPECT_EQ(flow_ffi::HandleRegistry::instance().get_handle_count(), 0);
-}
\ No newline at end of file
+}
+
+TEST_F(HandleManagerTest, ForEachHandleVisitsOnlyMatchingType) {
+    struct TypeA {
+        int a;
+    };
+    struct TypeB {
+        int b;
+    };
+
+    auto* a1 = flow_ffi::create_handle<TypeA>(TypeA{1});
+    auto* a2 = flow_ffi::create_handle<TypeA>(TypeA{2});
+    auto* b = flow_ffi::create_handle<TypeB>(TypeB{3});
+
+    int sum = 0;
+    std::vector<void*> visited;
+    flow_ffi::for_each_handle<TypeA>([&](void* handle, TypeA& object) {
+        visited.push_back(handle);
+        sum += object.a;
+        object.a *= 10;
+    });
+
+    EXPECT_EQ(visited.size(), 2u);
+    EXPECT_EQ(sum, 3);
+    EXPECT_EQ(flow_ffi::get_handle<TypeA>(a1)->a, 10);
+    EXPECT_EQ(flow_ffi::get_handle<TypeA>(a2)->a, 20);
+
+    flow_release_handle(a1);
+    flow_release_handle(a2);
+    flow_release_handle(b);
+}
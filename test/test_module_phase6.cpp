@@ -1,11 +1,14 @@
 #include "flow_ffi.h"
 
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
 
 #include "error_handling.hpp"
+#include "module_index.hpp"
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 namespace fs = std::filesystem;
 
@@ -230,6 +233,362 @@ TEST_F(ModuleTest, MultipleModules) {
     EXPECT_FALSE(flow_is_valid_handle(module2));
 }
 
+TEST_F(ModuleTest, LoadDirectoryWithInvalidArguments) {
+    FlowModuleLoadResult* results = nullptr;
+    size_t count = 0;
+
+    EXPECT_EQ(flow_modules_load_directory(nullptr, "/tmp", nullptr, &results, &count),
+              FLOW_ERROR_INVALID_HANDLE);
+    EXPECT_EQ(flow_modules_load_directory(factory_, nullptr, nullptr, &results, &count),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_modules_load_directory(factory_, "/tmp", nullptr, nullptr, &count),
+              FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_modules_load_directory(factory_, "/nonexistent/modules", nullptr, &results,
+                                          &count),
+              FLOW_ERROR_MODULE_LOAD_FAILED);
+    EXPECT_EQ(results, nullptr);
+    EXPECT_EQ(count, 0u);
+}
+
+TEST_F(ModuleTest, LoadDirectoryWithoutModules) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_empty_module_dir";
+    fs::create_directories(dir);
+
+    FlowModuleLoadResult* results = nullptr;
+    size_t count = 0;
+    EXPECT_EQ(flow_modules_load_directory(factory_, dir.string().c_str(), nullptr, &results,
+                                          &count),
+              FLOW_SUCCESS);
+    EXPECT_EQ(results, nullptr);
+    EXPECT_EQ(count, 0u);
+
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, LoadDirectoryReportsFailuresInSortedOrder) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_bad_module_dir";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    // Not real modules: both must fail, and non-.fmod entries must be ignored
+    fs::create_directories(dir / "b_broken.fmod");
+    fs::create_directories(dir / "a_broken.fmod");
+    fs::create_directories(dir / "not_a_module");
+
+    FlowModuleLoadOptions options{2, true, true, false, nullptr};
+    FlowModuleLoadResult* results = nullptr;
+    size_t count = 0;
+    EXPECT_EQ(flow_modules_load_directory(factory_, dir.string().c_str(), &options, &results,
+                                          &count),
+              FLOW_ERROR_MODULE_LOAD_FAILED);
+    ASSERT_EQ(count, 2u);
+    ASSERT_NE(results, nullptr);
+
+    EXPECT_NE(std::string(results[0].path).find("a_broken.fmod"), std::string::npos);
+    EXPECT_NE(std::string(results[1].path).find("b_broken.fmod"), std::string::npos);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(results[i].error, FLOW_ERROR_MODULE_LOAD_FAILED);
+        EXPECT_NE(results[i].error_message, nullptr);
+        EXPECT_EQ(results[i].module, nullptr);
+        EXPECT_GE(results[i].load_time_ms, 0.0);
+    }
+
+    flow_free_module_load_results(results, count);
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, LazyModuleWithInvalidHandle) {
+    EXPECT_EQ(flow_module_set_lazy(nullptr, true), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(flow_module_materialize(nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+    EXPECT_FALSE(flow_module_is_resident(nullptr));
+}
+
+TEST_F(ModuleTest, LazyModuleDefersLoading) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_lazy_module.fmod";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "LazyModule");
+    {
+        std::ofstream manifest(dir / "LazyModule" / "module.json");
+        manifest << R"({"Name": "LazyModule", "Version": "1.0.0", "Author": "flow",)"
+                 << R"( "Description": "Deferred test module"})";
+    }
+
+    auto module = flow_module_create(factory_);
+    ASSERT_NE(module, nullptr);
+    ASSERT_EQ(flow_module_set_lazy(module, true), FLOW_SUCCESS);
+
+    // Nothing is loaded yet, but the module answers from its manifest
+    EXPECT_EQ(flow_module_load(module, dir.string().c_str()), FLOW_SUCCESS);
+    EXPECT_TRUE(flow_module_is_loaded(module));
+    EXPECT_FALSE(flow_module_is_resident(module));
+    ASSERT_NE(flow_module_get_name(module), nullptr);
+    EXPECT_STREQ(flow_module_get_name(module), "LazyModule");
+    EXPECT_STREQ(flow_module_get_version(module), "1.0.0");
+    EXPECT_EQ(flow_module_register_nodes(module), FLOW_SUCCESS);
+
+    // The directory holds no library, so materializing fails and clears the pending state
+    EXPECT_EQ(flow_module_materialize(module), FLOW_ERROR_MODULE_LOAD_FAILED);
+    EXPECT_FALSE(flow_module_is_loaded(module));
+
+    EXPECT_EQ(flow_module_load(module, dir.string().c_str()), FLOW_SUCCESS);
+    EXPECT_EQ(flow_module_unload(module), FLOW_SUCCESS);
+    EXPECT_FALSE(flow_module_is_loaded(module));
+
+    flow_module_destroy(module);
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, LoadDirectoryLazily) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_lazy_module_dir";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "a_deferred.fmod");
+    fs::create_directories(dir / "b_deferred.fmod");
+
+    FlowModuleLoadOptions options{2, true, false, true, nullptr};
+    FlowModuleLoadResult* results = nullptr;
+    size_t count = 0;
+    EXPECT_EQ(flow_modules_load_directory(factory_, dir.string().c_str(), &options, &results,
+                                          &count),
+              FLOW_SUCCESS);
+    ASSERT_EQ(count, 2u);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(results[i].error, FLOW_SUCCESS);
+        ASSERT_NE(results[i].module, nullptr);
+        EXPECT_TRUE(flow_module_is_loaded(results[i].module));
+        EXPECT_FALSE(flow_module_is_resident(results[i].module));
+    }
+
+    // Unknown classes still fail once the deferred modules have been probed
+    EXPECT_EQ(flow_factory_create_node(factory_, "NoSuchLazyClass", nullptr, "n", env_), nullptr);
+    EXPECT_EQ(flow_ffi::ErrorManager::instance().get_last_error_code(), FLOW_ERROR_NODE_NOT_FOUND);
+
+    for (size_t i = 0; i < count; ++i) {
+        flow_module_destroy(results[i].module);
+    }
+    flow_free_module_load_results(results, count);
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, GraphJsonResolvesLazyClasses) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_lazy_json_module.fmod";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    auto module = flow_module_create(factory_);
+    ASSERT_NE(module, nullptr);
+    ASSERT_EQ(flow_module_set_lazy(module, true), FLOW_SUCCESS);
+    ASSERT_EQ(flow_module_load(module, dir.string().c_str()), FLOW_SUCCESS);
+    ASSERT_EQ(flow_module_register_nodes(module), FLOW_SUCCESS);
+    EXPECT_TRUE(flow_module_is_loaded(module));
+
+    // Loading a graph that uses a class only a deferred module may provide materializes
+    // the module; it has no library, so that fails, clears its pending state and leaves
+    // the class unknown
+    FlowGraphHandle graph = flow_graph_create(env_);
+    ASSERT_NE(graph, nullptr);
+    EXPECT_EQ(flow_graph_load_from_json(
+                  graph, R"({"nodes": [{"id": "00000000-0000-0000-0000-000000000001",)"
+                         R"( "class": "LazyJsonNode", "name": "n"}], "connections": []})"),
+              FLOW_ERROR_NODE_NOT_FOUND);
+    EXPECT_FALSE(flow_module_is_loaded(module));
+
+    flow_graph_destroy(graph);
+    flow_module_destroy(module);
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, ModuleIndexRoundTripAndFreshness) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_module_index";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "indexed.fmod");
+    {
+        std::ofstream lib(dir / "indexed.fmod" / "payload.bin");
+        lib << "v1";
+    }
+    auto module_path = dir / "indexed.fmod";
+    auto index_path = dir / "modules.index";
+
+    auto fingerprint = flow_ffi::module_fingerprint(module_path);
+    ASSERT_TRUE(fingerprint.has_value());
+    EXPECT_FALSE(flow_ffi::module_fingerprint(dir / "missing.fmod").has_value());
+
+    flow_ffi::ModuleIndex index;
+    EXPECT_FALSE(index.load(index_path));
+    index.update(module_path, {*fingerprint,
+                               {"Indexed", "1.0.0", "flow", "Indexed module"},
+                               {{"Math", "AddNode"}, {"Math", "MulNode"}}});
+    EXPECT_TRUE(index.dirty());
+    ASSERT_TRUE(index.save(index_path));
+
+    flow_ffi::ModuleIndex reloaded;
+    ASSERT_TRUE(reloaded.load(index_path));
+    const auto* entry = reloaded.find_fresh(module_path, *fingerprint);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->manifest.name, "Indexed");
+    ASSERT_EQ(entry->node_classes.size(), 2u);
+    EXPECT_EQ(entry->node_classes[1].class_name, "MulNode");
+
+    // Changing the module contents invalidates the entry
+    {
+        std::ofstream lib(dir / "indexed.fmod" / "payload.bin", std::ios::app);
+        lib << "v2";
+    }
+    auto changed = flow_ffi::module_fingerprint(module_path);
+    ASSERT_TRUE(changed.has_value());
+    EXPECT_EQ(reloaded.find_fresh(module_path, *changed), nullptr);
+
+    reloaded.retain({});
+    EXPECT_TRUE(reloaded.dirty());
+    EXPECT_EQ(reloaded.find_fresh(module_path, *fingerprint), nullptr);
+
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, LoadDirectoryDefersIndexedModules) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_indexed_module_dir";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "modules" / "cached.fmod");
+    auto module_path = dir / "modules" / "cached.fmod";
+    auto index_path = dir / "modules.index";
+
+    // Not a loadable module, so it can only succeed if it is served from the index
+    flow_ffi::ModuleIndex index;
+    index.update(module_path, {*flow_ffi::module_fingerprint(module_path),
+                               {"Cached", "2.0.0", "flow", "Cached module"},
+                               {{"IndexedCategory", "IndexedNode"}}});
+    ASSERT_TRUE(index.save(index_path));
+
+    std::string index_str = index_path.string();
+    FlowModuleLoadOptions options{2, true, false, false, index_str.c_str()};
+    FlowModuleLoadResult* results = nullptr;
+    size_t count = 0;
+    EXPECT_EQ(flow_modules_load_directory(factory_, (dir / "modules").string().c_str(), &options,
+                                          &results, &count),
+              FLOW_SUCCESS);
+    ASSERT_EQ(count, 1u);
+    ASSERT_NE(results[0].module, nullptr);
+    EXPECT_FALSE(flow_module_is_resident(results[0].module));
+    EXPECT_STREQ(flow_module_get_name(results[0].module), "Cached");
+
+    // The catalog lists the indexed class before the module is loaded
+    char** classes = nullptr;
+    size_t class_count = 0;
+    ASSERT_EQ(flow_factory_get_node_classes(factory_, "IndexedCategory", &classes, &class_count),
+              FLOW_SUCCESS);
+    ASSERT_EQ(class_count, 1u);
+    EXPECT_STREQ(classes[0], "IndexedNode");
+    flow_free_string_array(classes, class_count);
+
+    // A saved graph using the indexed class loads the module behind it, which fails here
+    // because the directory holds no library
+    FlowGraphHandle graph = flow_graph_create(env_);
+    ASSERT_NE(graph, nullptr);
+    EXPECT_EQ(flow_graph_load_from_json(
+                  graph, R"({"nodes": [{"id": "00000000-0000-0000-0000-000000000002",)"
+                         R"( "class": "IndexedNode", "name": "n"}], "connections": []})"),
+              FLOW_ERROR_NODE_NOT_FOUND);
+    EXPECT_FALSE(flow_module_is_loaded(results[0].module));
+    flow_graph_destroy(graph);
+
+    flow_module_destroy(results[0].module);
+    flow_free_module_load_results(results, count);
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, ReloadWithInvalidHandle) {
+    FlowModuleReloadStats stats{};
+    EXPECT_EQ(flow_module_reload(nullptr, &stats), FLOW_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(ModuleTest, ReloadWhenNotLoaded) {
+    auto module = flow_module_create(factory_);
+    ASSERT_NE(module, nullptr);
+
+    EXPECT_EQ(flow_module_reload(module, nullptr), FLOW_ERROR_MODULE_LOAD_FAILED);
+    EXPECT_NE(flow_get_last_error(), nullptr);
+
+    flow_module_destroy(module);
+}
+
+TEST_F(ModuleTest, ReloadDeferredModuleRereadsManifest) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_reload_module.fmod";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto write_manifest = [&dir](const std::string& version) {
+        std::ofstream manifest(dir / "module.json");
+        manifest << R"({"Name": "Reloaded", "Version": ")" << version << R"("})";
+    };
+    write_manifest("1.0.0");
+
+    auto module = flow_module_create(factory_);
+    ASSERT_NE(module, nullptr);
+    ASSERT_EQ(flow_module_set_lazy(module, true), FLOW_SUCCESS);
+    ASSERT_EQ(flow_module_load(module, dir.string().c_str()), FLOW_SUCCESS);
+    EXPECT_STREQ(flow_module_get_version(module), "1.0.0");
+
+    // Nothing is resident, so no nodes are migrated
+    write_manifest("1.1.0");
+    FlowModuleReloadStats stats{};
+    EXPECT_EQ(flow_module_reload(module, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.nodes_migrated, 0u);
+    EXPECT_EQ(stats.nodes_dropped, 0u);
+    EXPECT_STREQ(flow_module_get_version(module), "1.1.0");
+
+    flow_module_destroy(module);
+    fs::remove_all(dir);
+}
+
+TEST_F(ModuleTest, LoadStatsWithInvalidArguments) {
+    FlowModuleLoadStats stats{};
+    EXPECT_EQ(flow_module_get_load_stats(nullptr, &stats), FLOW_ERROR_INVALID_ARGUMENT);
+
+    auto module = flow_module_create(factory_);
+    ASSERT_NE(module, nullptr);
+    EXPECT_EQ(flow_module_get_load_stats(module, nullptr), FLOW_ERROR_INVALID_ARGUMENT);
+    flow_module_destroy(module);
+}
+
+TEST_F(ModuleTest, LoadStatsAndReportForDeferredModule) {
+    auto dir = fs::temp_directory_path() / "flow_ffi_stats_module.fmod";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    {
+        std::ofstream manifest(dir / "module.json");
+        manifest << R"({"Name": "Profiled", "Version": "1.0.0"})";
+    }
+
+    auto module = flow_module_create(factory_);
+    ASSERT_NE(module, nullptr);
+
+    FlowModuleLoadStats stats{};
+    ASSERT_EQ(flow_module_get_load_stats(module, &stats), FLOW_SUCCESS);
+    EXPECT_EQ(stats.load_count, 0);
+    EXPECT_FALSE(stats.resident);
+
+    ASSERT_EQ(flow_module_set_lazy(module, true), FLOW_SUCCESS);
+    ASSERT_EQ(flow_module_load(module, dir.string().c_str()), FLOW_SUCCESS);
+    ASSERT_EQ(flow_module_get_load_stats(module, &stats), FLOW_SUCCESS);
+    EXPECT_TRUE(stats.lazy);
+    EXPECT_FALSE(stats.resident);
+    EXPECT_FALSE(stats.from_index);
+    EXPECT_GE(stats.manifest_time_ms, 0.0);
+    EXPECT_EQ(stats.load_count, 0);
+    EXPECT_EQ(stats.node_classes_registered, 0u);
+
+    char* report = flow_modules_get_load_report();
+    ASSERT_NE(report, nullptr);
+    auto j = nlohmann::json::parse(report);
+    EXPECT_GE(j["ModuleCount"].get<size_t>(), 1u);
+    bool found = false;
+    for (const auto& entry : j["Modules"]) {
+        found = found || entry["Name"] == "Profiled";
+    }
+    EXPECT_TRUE(found);
+    flow_free_string(report);
+
+    flow_module_destroy(module);
+    fs::remove_all(dir);
+}
+
 // Integration test for the complete module lifecycle
 // Note: This test will fail until actual .fmod modules are available for testing
 TEST_F(ModuleTest, DISABLED_CompleteModuleLifecycle) {